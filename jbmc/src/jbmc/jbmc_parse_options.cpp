@@ -268,6 +268,27 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
     "slice-formula",
     cmdline.isset("slice-formula"));
 
+  // convert the equation while symex produces it
+  if(cmdline.isset("stream-equation"))
+  {
+    if(cmdline.isset("slice-formula"))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "--stream-equation cannot be combined with --slice-formula",
+        "--stream-equation");
+    }
+
+    // only the multi-path checker streams the equation
+    if(cmdline.isset("paths"))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "--stream-equation cannot be combined with --paths",
+        "--stream-equation");
+    }
+
+    options.set_option("stream-equation", true);
+  }
+
   // simplify if conditions and branches
   if(cmdline.isset("no-simplify-if"))
     options.set_option("simplify-if", false);
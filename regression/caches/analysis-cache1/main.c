@@ -0,0 +1,21 @@
+#include <assert.h>
+
+int x;
+
+void set(void)
+{
+  x = 1;
+}
+
+void check(int a)
+{
+  assert(a == 5);
+}
+
+int main(void)
+{
+  set();
+  assert(x == 1);
+  check(5);
+  return 0;
+}
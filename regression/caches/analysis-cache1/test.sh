@@ -0,0 +1,24 @@
+options="--verify --constants"
+
+"${goto_analyzer}" ${options} main.c > uncached.out 2>&1
+"${goto_analyzer}" ${options} --cache-dir "${cache_dir}" main.c > first.out 2>&1
+"${goto_analyzer}" ${options} --cache-dir "${cache_dir}" main.c > second.out 2>&1
+status=$?
+
+for run in first second; do
+  if grep -q "^Reused cached results of the analysis$" ${run}.out; then
+    echo "${run} run: results taken from the cache"
+  else
+    echo "${run} run: program analysed"
+  fi
+  grep "^\[[a-z]*\.assertion\.[0-9]*\]" ${run}.out > ${run}.results
+done
+grep "^\[[a-z]*\.assertion\.[0-9]*\]" uncached.out > uncached.results
+
+cat second.results
+cmp -s uncached.results first.results &&
+  cmp -s uncached.results second.results &&
+  echo "same results with and without the cache"
+
+rm -f ./*.out ./*.results
+exit ${status}
@@ -0,0 +1,15 @@
+#!/usr/bin/env bash
+#
+# Run the test script given as the input file, with the paths of the tools
+# and of a new, empty cache directory in the environment
+
+goto_cc=$1
+cbmc=$2
+goto_analyzer=$3
+name=${*:$#}
+
+cache_dir=$(mktemp -d)
+trap 'rm -rf "${cache_dir}"' EXIT
+
+export goto_cc cbmc goto_analyzer cache_dir
+bash "${name}"
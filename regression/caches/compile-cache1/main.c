@@ -0,0 +1,7 @@
+#include "header.h"
+
+int main(void)
+{
+  __CPROVER_assert(VALUE == 2, "value from the header");
+  return 0;
+}
@@ -0,0 +1,24 @@
+export GOTO_CC_CACHE="${cache_dir}/objects"
+
+cp main.c "${cache_dir}"
+cd "${cache_dir}" || exit 1
+
+compile()
+{
+  if "${goto_cc}" --verbosity 10 -c main.c -o main.gb 2>&1 |
+    grep -q "Cache hit: "; then
+    echo "$1: hit"
+  else
+    echo "$1: miss"
+  fi
+}
+
+echo "#define VALUE 1" > header.h
+compile "first compilation"
+compile "second compilation"
+
+echo "#define VALUE 2" > header.h
+compile "compilation after changing the header"
+
+"${goto_cc}" --cache-statistics
+"${cbmc}" main.gb
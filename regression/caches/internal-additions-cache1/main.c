@@ -0,0 +1,12 @@
+int main(void)
+{
+  int array[2];
+  int *p = array;
+
+  __CPROVER_assert(__CPROVER_r_ok(p, sizeof(array)), "array readable");
+  __CPROVER_assert(
+    __CPROVER_POINTER_OBJECT(p) == __CPROVER_POINTER_OBJECT(array + 1),
+    "same object");
+  __CPROVER_assert(__CPROVER_r_ok(p, sizeof(array) + 1), "beyond array");
+  return 0;
+}
@@ -0,0 +1,30 @@
+"${cbmc}" --show-symbol-table main.c > uncached.symbols 2>&1
+"${cbmc}" main.c > uncached.out 2>&1
+
+export CPROVER_LIBRARY_CACHE="${cache_dir}"
+"${cbmc}" --show-symbol-table main.c > first.symbols 2>&1
+"${cbmc}" --verbosity 10 --show-symbol-table main.c > second.symbols 2>&1
+"${cbmc}" main.c > cached.out 2>&1
+status=$?
+
+grep -q "^Building precompiled internal additions " first.symbols &&
+  echo "first run: internal additions built"
+grep -q "^Using precompiled internal additions " second.symbols &&
+  echo "second run: internal additions taken from the cache"
+
+for run in uncached first second; do
+  sed -n '/^Symbols:$/,$p' ${run}.symbols > ${run}.table
+done
+test -s uncached.table &&
+  cmp -s uncached.table first.table &&
+  cmp -s uncached.table second.table &&
+  echo "same symbol table with and without the cache"
+
+grep "^\[main\.assertion\.[0-9]*\]" uncached.out > uncached.results
+grep "^\[main\.assertion\.[0-9]*\]" cached.out > cached.results
+cat cached.results
+cmp -s uncached.results cached.results &&
+  echo "same results with and without the cache"
+
+rm -f ./*.symbols ./*.table ./*.out ./*.results
+exit ${status}
@@ -0,0 +1,12 @@
+#include <assert.h>
+#include <string.h>
+
+int main(void)
+{
+  char buffer[2];
+  buffer[1] = 0;
+
+  assert(strlen("abc") == 3);
+  assert(strlen(buffer) == 1);
+  return 0;
+}
@@ -0,0 +1,22 @@
+"${cbmc}" main.c > uncached.out 2>&1
+
+export CPROVER_LIBRARY_CACHE="${cache_dir}"
+"${cbmc}" main.c > first.out 2>&1
+"${cbmc}" --verbosity 10 main.c > second.out 2>&1
+status=$?
+
+grep -q "^Building precompiled library " first.out &&
+  echo "first run: library built"
+grep -q "^Using precompiled library " second.out &&
+  echo "second run: library taken from the cache"
+
+for run in uncached first second; do
+  grep "^\[main\.assertion\.[0-9]*\]" ${run}.out > ${run}.results
+done
+cat second.results
+cmp -s uncached.results first.results &&
+  cmp -s uncached.results second.results &&
+  echo "same results with and without the cache"
+
+rm -f ./*.out ./*.results
+exit ${status}
@@ -0,0 +1,23 @@
+export CPROVER_LIBRARY_CACHE="${cache_dir}"
+
+"${cbmc}" --32 main.c > /dev/null 2>&1
+library_32=$(ls "${cache_dir}"/cprover_library_*)
+"${cbmc}" --64 main.c > /dev/null 2>&1
+
+# Make the entry for --64 hold the library for --32, as if the names of the
+# two entries collided
+for entry in "${cache_dir}"/cprover_library_*; do
+  if [ "${entry}" != "${library_32}" ]; then
+    cp "${library_32}" "${entry}"
+  fi
+done
+
+"${cbmc}" --64 main.c > collided.out 2>&1
+status=$?
+
+grep -q "^Building precompiled library " collided.out &&
+  echo "library for a different configuration rebuilt"
+grep "^\[main\.assertion\.[0-9]*\]" collided.out
+
+rm -f ./*.out
+exit ${status}
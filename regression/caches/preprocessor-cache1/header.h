@@ -0,0 +1,3 @@
+#define Aa 1
+#define BB 2
+#define VALUE Aa
@@ -0,0 +1,29 @@
+export CPROVER_PREPROCESSOR_CACHE="${cache_dir}"
+
+# work on a copy, as the header is changed below
+work_dir=$(mktemp -d)
+trap 'rm -rf "${work_dir}"' EXIT
+cp main.c header.h "${work_dir}"
+cd "${work_dir}" || exit 1
+
+compile()
+{
+  if "${goto_cc}" --verbosity 10 -c main.c -o main.gb 2>&1 |
+    grep -q "Preprocessed output of 'main.c' taken from "; then
+    echo "$1 run: preprocessor output taken from the cache"
+  else
+    echo "$1 run: preprocessor run"
+  fi
+}
+
+compile first
+compile second
+"${cbmc}" main.gb > /dev/null
+echo "unchanged header: EXIT=$?"
+
+# "Aa" and "BB" have the same hash with a simple multiplicative string hash
+printf '#define Aa 1\n#define BB 2\n#define VALUE BB\n' > header.h
+
+compile third
+"${cbmc}" main.gb > /dev/null
+echo "changed header: EXIT=$?"
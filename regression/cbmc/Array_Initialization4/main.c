@@ -0,0 +1,39 @@
+#include <assert.h>
+
+// large arrays: the initializers are not expanded element by element
+int table[1000000] = {1, 2, [500000] = 3, [999999] = 4, [7] = 5};
+char buffer[1 << 20] = "abc";
+
+struct S
+{
+  int a[5000];
+  int b;
+};
+
+struct S s = {{[10] = 1, 2}, 3};
+
+int main()
+{
+  int local[2000] = {[1999] = 42};
+
+  assert(table[0] == 1);
+  assert(table[1] == 2);
+  assert(table[2] == 0);
+  assert(table[7] == 5);
+  assert(table[500000] == 3);
+  assert(table[999999] == 4);
+
+  assert(buffer[0] == 'a');
+  assert(buffer[3] == 0);
+  assert(buffer[1000] == 0);
+
+  assert(s.a[10] == 1);
+  assert(s.a[11] == 2);
+  assert(s.a[0] == 0);
+  assert(s.b == 3);
+
+  assert(local[1999] == 42);
+  assert(local[0] == 0);
+
+  return 0;
+}
@@ -0,0 +1,42 @@
+#include <assert.h>
+
+int a = 1, b = 2, c = 3;
+
+// large arrays: the initializers are not expanded element by element, the
+// points-to sets must still include each initialized element
+int *table[2000] = {[0] = &a, [5] = &b, [1999] = &c};
+
+int increment(int x)
+{
+  return x + 1;
+}
+
+int decrement(int x)
+{
+  return x - 1;
+}
+
+int (*operations[1500])(int) = {[3] = increment, [700] = decrement};
+
+int main()
+{
+  unsigned i;
+  __CPROVER_assume(i == 0 || i == 5 || i == 1999);
+  int *p = table[i];
+  assert(*p == (i == 0 ? 1 : i == 5 ? 2 : 3));
+
+  unsigned j;
+  __CPROVER_assume(j < 2000 && j != 0 && j != 5 && j != 1999);
+  assert(table[j] == 0);
+
+  int *local[3000] = {[2] = &a, [2500] = &c};
+  unsigned k;
+  __CPROVER_assume(k == 2 || k == 2500);
+  assert(*local[k] == (k == 2 ? 1 : 3));
+
+  unsigned n;
+  __CPROVER_assume(n == 3 || n == 700);
+  assert(operations[n](10) == (n == 3 ? 11 : 9));
+
+  return 0;
+}
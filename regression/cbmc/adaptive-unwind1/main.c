@@ -0,0 +1,14 @@
+int main()
+{
+  int sum = 0;
+
+  for(int i = 0; i < 5; ++i)
+    sum += i;
+
+  for(int j = 0; j < 1; ++j)
+    sum += j;
+
+  __CPROVER_assert(sum == 10, "sum");
+
+  return 0;
+}
@@ -0,0 +1,10 @@
+int main()
+{
+  int n;
+  __CPROVER_assume(n < 100);
+
+  for(int i = 0; i < n; ++i)
+    ;
+
+  return 0;
+}
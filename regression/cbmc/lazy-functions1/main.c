@@ -0,0 +1,24 @@
+#include <assert.h>
+
+int called(int x)
+{
+  return x + 1;
+}
+
+int address_taken(int x)
+{
+  return x * 2;
+}
+
+int unused(int x)
+{
+  return called(x) - 1;
+}
+
+int main(void)
+{
+  int (*fp)(int) = address_taken;
+  assert(called(1) == 2);
+  assert(fp(2) == 4);
+  return 0;
+}
@@ -0,0 +1,16 @@
+int main()
+{
+  int x;
+  int sum = 0;
+
+  // enough steps to have the equation streamed while symex runs
+  for(int i = 0; i < 3000; ++i)
+  {
+    __CPROVER_assume(x >= 0 && x < 10);
+    sum += x;
+  }
+
+  __CPROVER_assert(sum < 9 * 3000, "not all maximal");
+
+  return 0;
+}
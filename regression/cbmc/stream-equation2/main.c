@@ -0,0 +1,16 @@
+int main()
+{
+  int x;
+  int sum = 0;
+
+  for(int i = 0; i < 3000; ++i)
+  {
+    __CPROVER_assume(x >= 0 && x < 10);
+    sum += x;
+  }
+
+  __CPROVER_assert(sum <= 9 * 3000, "bounded");
+  __CPROVER_assert(sum >= 0, "non-negative");
+
+  return 0;
+}
@@ -0,0 +1,17 @@
+#include <pthread.h>
+
+int shared;
+
+void *worker(void *arg)
+{
+  shared = 1;
+  return 0;
+}
+
+int main()
+{
+  pthread_t thread;
+  pthread_create(&thread, 0, worker, 0);
+  __CPROVER_assert(shared == 0 || shared == 1, "values");
+  return 0;
+}
@@ -0,0 +1,10 @@
+#include <assert.h>
+
+int main(void)
+{
+  int x = 1;
+  int y = x + 1;
+  assert(y == 2);
+  assert(y == 3);
+  return 0;
+}
@@ -0,0 +1,24 @@
+#include <assert.h>
+
+int x;
+
+void set(void)
+{
+  x = 6;
+}
+
+void increment(void)
+{
+  x = x + 1;
+}
+
+int main(void)
+{
+  set();
+  assert(x == 6);
+  increment();
+  assert(x == 7);
+  x = 0;
+  assert(x == 6);
+  return 0;
+}
@@ -0,0 +1,30 @@
+#include <assert.h>
+
+int main(int argc, char **argv)
+{
+  int x = 0;
+
+  while(argc > 5)
+  {
+    // every path assigns a constant, but x only reaches 5 after five
+    // iterations
+    if(x == 0)
+      x = 1;
+    else if(x == 1)
+      x = 2;
+    else if(x == 2)
+      x = 3;
+    else if(x == 3)
+      x = 4;
+    else if(x == 4)
+      x = 5;
+    else
+      x = 0;
+    --argc;
+  }
+
+  assert(x >= 0);
+  assert(x <= 5);
+
+  return 0;
+}
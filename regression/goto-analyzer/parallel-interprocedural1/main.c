@@ -0,0 +1,22 @@
+#include <assert.h>
+
+int f(int x)
+{
+  return x + 1;
+}
+
+int g(int y)
+{
+  assert(y > 0);
+  return y;
+}
+
+int main(int argc, char **argv)
+{
+  int a = f(1);
+  int b = g(5);
+  assert(a == 2);
+  assert(b == 5);
+
+  return 0;
+}
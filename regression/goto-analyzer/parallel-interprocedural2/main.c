@@ -0,0 +1,17 @@
+#include <assert.h>
+
+int f(int x)
+{
+  return x + 1;
+}
+
+int main(int argc, char **argv)
+{
+  int a = f(1);
+  int b = f(3);
+  int c = 7;
+  assert(c == 7);
+  assert(b == 4);
+
+  return 0;
+}
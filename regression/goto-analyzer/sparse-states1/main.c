@@ -0,0 +1,25 @@
+#include <assert.h>
+
+int inc(int x)
+{
+  int y = x + 1;
+  return y;
+}
+
+int main(void)
+{
+  int a = 1;
+  int b = a + 2;
+  int c = inc(b);
+  int d = c * 2;
+  assert(b == 3);
+  assert(c == 4);
+  assert(d == 8);
+
+  for(int i = 0; i < 10; ++i)
+    d = 8;
+
+  assert(d == 8);
+  assert(a == 2);
+  return 0;
+}
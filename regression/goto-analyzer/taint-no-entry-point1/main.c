@@ -0,0 +1,17 @@
+void source(char *);
+
+void sink(char *p)
+{
+  (void)p;
+}
+
+void f(void)
+{
+  char x, y;
+  char *a = &x;
+  char *b = &y;
+
+  source(a);
+  sink(a);
+  sink(b);
+}
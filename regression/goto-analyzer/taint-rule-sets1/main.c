@@ -0,0 +1,20 @@
+void source_a(char *);
+void source_b(char *);
+void sink_a(char *);
+void sink_b(char *);
+
+int main(void)
+{
+  char x, y;
+  char *a = &x;
+  char *b = &y;
+
+  source_a(a);
+  source_b(b);
+
+  sink_a(a);
+  sink_b(a);
+  sink_b(b);
+
+  return 0;
+}
@@ -0,0 +1,26 @@
+void source_a(char *);
+void source_b(char *);
+void source_c(char *);
+void sink_a(char *);
+void sink_b(char *);
+void sink_c(char *);
+
+int main(void)
+{
+  char x, y, z;
+  char *a = &x;
+  char *b = &y;
+  char *c = &z;
+
+  source_a(a);
+  source_b(b);
+  source_c(c);
+
+  sink_a(a);
+  sink_b(a);
+  sink_b(b);
+  sink_c(b);
+  sink_c(c);
+
+  return 0;
+}
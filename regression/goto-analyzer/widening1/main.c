@@ -0,0 +1,20 @@
+#include <assert.h>
+
+int main(int argc, char **argv)
+{
+  int x = 0;
+
+  while(argc > 5)
+  {
+    if(argc > 10)
+      x = 1;
+    else
+      x = 2;
+    --argc;
+  }
+
+  assert(x >= 0);
+  assert(x <= 2);
+
+  return 0;
+}
@@ -0,0 +1,11 @@
+#!/usr/bin/env bash
+#
+# Run the test script given as the input file, with the paths of the tools in
+# the environment
+
+goto_cc=$1
+cbmc=$2
+name=${*:$#}
+
+export goto_cc cbmc
+bash "${name}"
@@ -0,0 +1,13 @@
+int f(int x)
+{
+  return x < 0 ? -x : x;
+}
+
+int main(void)
+{
+  int x;
+  __CPROVER_assume(x > -10);
+  __CPROVER_assert(f(x) >= 0, "f non-negative");
+  __CPROVER_assert(f(x) < 5, "f small");
+  return 0;
+}
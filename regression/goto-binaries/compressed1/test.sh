@@ -0,0 +1,32 @@
+"${goto_cc}" -c main.c -o uncompressed.gb
+"${goto_cc}" --compress-goto-binary -c main.c -o compressed.gb
+
+# the header: magic number, version 6 and the flags
+header()
+{
+  head -c 6 "$1" | od -An -tx1 | tr -d ' \n'
+}
+
+echo "uncompressed header: $(header uncompressed.gb)"
+echo "compressed header: $(header compressed.gb)"
+
+# without the flags, the contents are those of a binary of version 5
+{
+  head -c 4 uncompressed.gb
+  printf '\005'
+  tail -c +7 uncompressed.gb
+} > version5.gb
+
+for binary in uncompressed compressed version5; do
+  "${cbmc}" ${binary}.gb > ${binary}.out 2>&1
+  echo "${binary}: EXIT=$?"
+  grep "^\[main\.assertion\.[0-9]*\]" ${binary}.out > ${binary}.results
+done
+
+cat uncompressed.results
+cmp -s uncompressed.results compressed.results &&
+  echo "same results for the compressed binary"
+cmp -s uncompressed.results version5.results &&
+  echo "same results for the binary of version 5"
+
+rm -f ./*.gb ./*.out ./*.results
@@ -0,0 +1,9 @@
+#include <assert.h>
+
+int other(int);
+
+int main()
+{
+  assert(other(1) == 2);
+  return 0;
+}
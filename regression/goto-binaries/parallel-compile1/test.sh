@@ -0,0 +1,11 @@
+"${goto_cc}" --jobs 2 --verbosity 10 other.c main.c -o main.gb > compile.out 2>&1
+echo "compile: EXIT=$?"
+
+# the objects compiled by the parallel processes, in the order they are read
+echo "read objects:" $(sed -n 's|^Reading: .*/\([0-9]*\.gb\)$|\1|p' compile.out)
+
+"${cbmc}" main.gb > verify.out 2>&1
+echo "verify: EXIT=$?"
+grep "^\[main\.assertion\.[0-9]*\]" verify.out
+
+rm -f ./*.gb ./*.out
@@ -0,0 +1,19 @@
+rm -f main.o other.o
+
+"${goto_cc}" -c main.c other.c --jobs 2
+echo "compile: EXIT=$?"
+
+for object in main.o other.o; do
+  if [ -f "${object}" ]; then
+    echo "${object} written"
+  fi
+done
+
+"${goto_cc}" main.o other.o -o linked.gb
+echo "link: EXIT=$?"
+
+"${cbmc}" linked.gb > verify.out 2>&1
+echo "verify: EXIT=$?"
+grep "^\[main\.assertion\.[0-9]*\]" verify.out
+
+rm -f ./*.o ./*.gb ./*.out
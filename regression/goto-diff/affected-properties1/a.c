@@ -0,0 +1,10 @@
+int main()
+{
+  int x;
+  int y = 1;
+
+  __CPROVER_assert(y == 1, "unchanged");
+  __CPROVER_assert(x > 0, "depends on x");
+
+  return 0;
+}
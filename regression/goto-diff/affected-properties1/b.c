@@ -0,0 +1,15 @@
+int main()
+{
+  int x = 42;
+  int y = 1;
+
+  __CPROVER_assert(y == 1, "unchanged");
+  __CPROVER_assert(x > 0, "depends on x");
+
+  return 0;
+}
+
+void bar(int z)
+{
+  __CPROVER_assert(z != 0, "new function");
+}
@@ -0,0 +1,17 @@
+int main()
+{
+  int x;
+  int y = 1;
+
+  __CPROVER_assert(y == 1, "first");
+  __CPROVER_assert(x > 0, "second");
+
+  return 0;
+}
+
+int other()
+{
+  int z = 1;
+  __CPROVER_assert(z == 1, "unchanged function");
+  return z;
+}
@@ -0,0 +1,18 @@
+int nondet_int();
+
+int square(int x)
+{
+  return x * x;
+}
+
+int main()
+{
+  int x = nondet_int();
+  int y = nondet_int();
+  int z = square(x);
+
+  __CPROVER_assert(z >= 0 || x != 0, "square of zero");
+  __CPROVER_assert(y != 42, "not 42");
+
+  return 0;
+}
@@ -0,0 +1,37 @@
+#include <stdio.h>
+
+void f1(void) { printf("%i\n", 1); }
+void f2(void) { printf("%i\n", 2); }
+void f3(void) { printf("%i\n", 3); }
+void f4(void) { printf("%i\n", 4); }
+
+typedef void (*void_fp)(void);
+
+// All functions have their address taken, so the type alone does not
+// narrow down the targets
+const void_fp fp_all[] = {f1, f2, f3, f4};
+
+void_fp global_fp;
+
+void set(void_fp fp)
+{
+  global_fp = fp;
+}
+
+void call(void_fp *fpp)
+{
+  (*fpp)();
+}
+
+int main(int argc, char *argv[])
+{
+  void_fp fp = f2;
+  if(argc > 1)
+    fp = f3;
+  fp();
+
+  set(f4);
+  call(&global_fp);
+
+  return 0;
+}
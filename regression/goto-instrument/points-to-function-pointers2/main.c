@@ -0,0 +1,19 @@
+#include <stdio.h>
+
+void f1(void) { printf("%i\n", 1); }
+void f2(void) { printf("%i\n", 2); }
+void f3(void) { printf("%i\n", 3); }
+
+typedef void (*void_fp)(void);
+
+const void_fp fp_all[] = {f1, f2, f3};
+
+int main(int argc, char *argv[])
+{
+  // an integer converted to a pointer may point to any function
+  int x = 0x1234;
+  void_fp fp = (void_fp)x;
+  fp();
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+#include <stdio.h>
+
+void f1(void) { printf("%i\n", 1); }
+void f2(void) { printf("%i\n", 2); }
+void f3(void) { printf("%i\n", 3); }
+void f4(void) { printf("%i\n", 4); }
+
+typedef void (*void_fp)(void);
+
+const void_fp fp_all[] = {f1, f2, f3};
+
+void_fp other = f4;
+
+int main(int argc, char *argv[])
+{
+  // dispatch through the table: only its entries are candidates
+  void_fp fp = fp_all[argc % 3];
+  fp();
+
+  return 0;
+}
@@ -0,0 +1,65 @@
+#!/bin/bash
+#
+# Compare widening and narrowing settings of the interval analysis of
+# goto-analyzer on each C test of regression/goto-analyzer.
+#
+# Usage: ai_iteration_regression.sh <goto-analyzer>
+#
+# Prints one line "test;steps;proved" per test and setting, where steps is
+# the number of abstract interpretation steps and proved the number of
+# properties shown to hold, followed by the totals for each setting.
+
+set -e
+
+if [ $# -lt 1 ] ; then
+  echo "Usage: $0 <goto-analyzer>" >&2
+  exit 1
+fi
+
+goto_analyzer=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+tests_dir=$(cd "$(dirname "$0")/../../regression/goto-analyzer" && pwd)
+
+settings=(
+  "no widening;"
+  "delay 0;--widening-delay 0"
+  "delay 2;--widening-delay 2"
+  "delay 0, narrowing 1;--widening-delay 0 --narrowing-passes 1"
+  "delay 2, narrowing 1;--widening-delay 2 --narrowing-passes 1"
+)
+
+for setting in "${settings[@]}" ; do
+  name=${setting%%;*}
+  options=${setting#*;}
+  echo "# $name"
+
+  total_steps=0
+  total_proved=0
+
+  for desc in "$tests_dir"/*/test.desc ; do
+    dir=$(dirname "$desc")
+    test=$(basename "$dir")
+    # the second line of test.desc names the source file
+    source=$(sed -n 2p "$desc")
+    case "$source" in
+      *.c) ;;
+      *) continue ;;
+    esac
+
+    set +e
+    # shellcheck disable=SC2086
+    output=$(cd "$dir" && "$goto_analyzer" --verify --intervals \
+      --verbosity 8 $options "$source" 2>&1)
+    set -e
+
+    steps=$(echo "$output" |
+      sed -n 's/^Abstract interpretation took \([0-9]*\) steps$/\1/p')
+    [ -n "$steps" ] || continue
+    proved=$(echo "$output" | grep -c ': SUCCESS$' || true)
+
+    echo "$test;$steps;$proved"
+    total_steps=$((total_steps + steps))
+    total_proved=$((total_proved + proved))
+  done
+
+  echo "total;$total_steps;$total_proved"
+done
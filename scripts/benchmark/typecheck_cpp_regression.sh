@@ -0,0 +1,51 @@
+#!/bin/bash
+#
+# Time the C++ front end of goto-cc on each test of regression/cpp.
+#
+# Usage: typecheck_cpp_regression.sh <goto-cc> [<repetitions>]
+#
+# Prints one line "test;seconds;exit code" per test, where seconds is the
+# fastest of the repetitions, followed by the total time.
+
+set -e
+
+if [ $# -lt 1 ] ; then
+  echo "Usage: $0 <goto-cc> [<repetitions>]" >&2
+  exit 1
+fi
+
+goto_cc=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+repetitions=${2:-1}
+tests_dir=$(cd "$(dirname "$0")/../../regression/cpp" && pwd)
+out=$(mktemp -d)
+trap 'rm -rf "$out"' EXIT
+
+total=0
+
+for desc in "$tests_dir"/*/test.desc ; do
+  dir=$(dirname "$desc")
+  test=$(basename "$dir")
+  # the second line of test.desc names the source file, the third holds the
+  # options
+  source=$(sed -n 2p "$desc")
+  options=$(sed -n 3p "$desc")
+
+  best=
+  for i in $(seq "$repetitions") ; do
+    start=$(date +%s.%N)
+    set +e
+    # shellcheck disable=SC2086
+    (cd "$dir" && "$goto_cc" $options -c "$source" -o "$out/$test.gb" \
+      >/dev/null 2>&1)
+    result=$?
+    set -e
+    end=$(date +%s.%N)
+    best=$(awk -v s="$start" -v e="$end" -v b="$best" \
+      'BEGIN { t = e - s; if(b == "" || t < b) b = t; printf "%.3f", b }')
+  done
+
+  echo "$test;$best;$result"
+  total=$(awk -v t="$total" -v b="$best" 'BEGIN { printf "%.3f", t + b }')
+done
+
+echo "total;$total"
@@ -11,10 +11,20 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "ai.h"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <sstream>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#ifdef CPROVER_THREAD_SAFE
+#include <atomic>
+#include <exception>
+#include <thread>
+#endif
 
 #include <util/invariant.h>
 #include <util/std_code.h>
@@ -208,6 +218,8 @@ ai_baset::trace_ptrt ai_baset::get_next(working_sett &working_set)
 {
   PRECONDITION(!working_set.empty());
 
+  ++steps;
+
   static_assert(
     std::is_same<
       working_sett,
@@ -308,6 +320,9 @@ bool ai_baset::visit(
     }
   }
 
+  if(sparse_states && is_prunable(l, goto_program))
+    prune(function_id, l, ns);
+
   return new_data;
 }
 
@@ -458,6 +473,195 @@ bool ai_baset::visit_end_function(
   return false;
 }
 
+bool ai_baset::should_widen(trace_ptrt from, trace_ptrt to)
+{
+  if(!widening_delay.has_value())
+    return false;
+
+  // Every cycle contains a backwards goto, hence their targets suffice as
+  // widening points
+  const locationt l_from = from->current_location();
+  const locationt l_to = to->current_location();
+  if(!l_from->is_backwards_goto() || l_from->get_target() != l_to)
+    return false;
+
+#ifdef CPROVER_THREAD_SAFE
+  std::lock_guard<std::mutex> lock(widening_point_joins_mutex);
+#endif
+  return ++widening_point_joins[l_to] > *widening_delay;
+}
+
+void ai_baset::narrow(
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  if(narrowing_passes == 0)
+    return;
+
+  forall_goto_functions(f_it, goto_functions)
+  {
+    if(f_it->second.body_available())
+      narrow(f_it->first, f_it->second.body, goto_functions, ns);
+  }
+}
+
+void ai_baset::narrow(
+  const irep_idt &function_id,
+  const goto_programt &goto_program,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  if(narrowing_passes == 0)
+    return;
+
+  PRECONDITION(
+    dynamic_cast<location_sensitive_storaget *>(storage.get()) != nullptr);
+  PRECONDITION(!sparse_states);
+
+  // Predecessors within the function, as far as they are not calls to
+  // functions with a body, as with those the state after the call comes from
+  // the end of the callee
+  std::unordered_map<
+    locationt,
+    std::vector<locationt>,
+    const_target_hash,
+    pointee_address_equalt>
+    predecessors;
+  std::unordered_set<locationt, const_target_hash, pointee_address_equalt>
+    kept;
+  kept.insert(goto_program.instructions.begin());
+
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    if(
+      i_it->is_function_call() &&
+      i_it->get_function_call().function().id() == ID_symbol)
+    {
+      const auto callee_it = goto_functions.function_map.find(
+        to_symbol_expr(i_it->get_function_call().function())
+          .get_identifier());
+      if(
+        callee_it != goto_functions.function_map.end() &&
+        callee_it->second.body_available())
+      {
+        kept.insert(std::next(i_it));
+        continue;
+      }
+    }
+
+    for(const auto &to_l : goto_program.get_successors(i_it))
+    {
+      if(to_l != goto_program.instructions.end())
+        predecessors[to_l].push_back(i_it);
+    }
+  }
+
+  for(std::size_t pass = 0; pass < narrowing_passes; ++pass)
+  {
+    // States are replaced in place, so that later locations already use
+    // the refined states of earlier ones. The state of a post-fixed point
+    // after any number of applications of the transformers remains sound.
+    forall_goto_program_instructions(i_it, goto_program)
+    {
+      const auto to_traces = storage->abstract_traces_before(i_it);
+      if(kept.find(i_it) != kept.end() || to_traces->empty())
+        continue;
+
+      ++steps;
+      trace_ptrt to_p = *to_traces->begin();
+      std::unique_ptr<statet> new_state = domain_factory->make(i_it);
+
+      for(const auto &from_l : predecessors[i_it])
+      {
+        const auto from_traces = storage->abstract_traces_before(from_l);
+        if(from_traces->empty())
+          continue;
+
+        trace_ptrt from_p = *from_traces->begin();
+        const statet &from_state = get_state(from_p);
+        if(from_state.is_bottom())
+          continue;
+
+        std::unique_ptr<statet> tmp_state(make_temporary_state(from_state));
+        tmp_state->transform(
+          function_id, from_p, function_id, to_p, *this, ns);
+        domain_factory->merge(*new_state, *tmp_state, from_p, to_p);
+      }
+
+      statet &to_state = get_state(to_p);
+      to_state.make_bottom();
+      domain_factory->merge(to_state, *new_state, to_p, to_p);
+    }
+  }
+}
+
+bool ai_baset::is_prunable(locationt l, const goto_programt &goto_program)
+{
+  // The previous instruction must be the only predecessor, and the states at
+  // calls and at the end of functions are used by the interprocedural
+  // analysis
+  return l != goto_program.instructions.begin() && !l->is_target() &&
+         !l->is_function_call() && !l->is_end_function() &&
+         !std::prev(l)->is_function_call();
+}
+
+void ai_baset::prune(
+  const irep_idt &function_id,
+  locationt l,
+  const namespacet &ns)
+{
+  PRECONDITION(
+    dynamic_cast<location_sensitive_storaget *>(storage.get()) != nullptr);
+
+  if(!sparse_ns.has_value())
+    sparse_ns = ns;
+
+  pruned_locations[l] = function_id;
+  storage->prune(l);
+}
+
+ai_baset::cstate_ptrt ai_baset::recompute_state_before(locationt l) const
+{
+  if(storage->abstract_traces_before(l)->empty())
+    return storage->abstract_state_before(l, *domain_factory);
+
+  // Walk back to the nearest location with a kept state
+  std::vector<locationt> path;
+  irep_idt function_id;
+  locationt from = l;
+  for(auto it = pruned_locations.find(from); it != pruned_locations.end();
+      it = pruned_locations.find(from))
+  {
+    function_id = it->second;
+    path.push_back(from);
+    from = std::prev(from);
+  }
+
+  std::unique_ptr<statet> state =
+    domain_factory->copy(*storage->abstract_state_before(from, *domain_factory));
+
+  for(auto it = path.rbegin(); it != path.rend(); ++it)
+  {
+    const auto from_traces = storage->abstract_traces_before(from);
+    const auto to_traces = storage->abstract_traces_before(*it);
+    INVARIANT(
+      !from_traces->empty() && !to_traces->empty(),
+      "the predecessors of a reached location are reached");
+
+    // Transformers take the analysis as non-const, but only query it
+    state->transform(
+      function_id,
+      *from_traces->begin(),
+      function_id,
+      *to_traces->begin(),
+      const_cast<ai_baset &>(*this),
+      *sparse_ns);
+    from = *it;
+  }
+
+  return cstate_ptrt(state.release());
+}
+
 bool ai_recursive_interproceduralt::visit_edge_function_call(
   const irep_idt &calling_function_id,
   trace_ptrt p_call,
@@ -533,3 +737,228 @@ bool ai_recursive_interproceduralt::visit_edge_function_call(
     return new_data;
   }
 }
+
+ai_parallel_interproceduralt::ai_parallel_interproceduralt(
+  std::unique_ptr<ai_history_factory_baset> &&hf,
+  std::unique_ptr<ai_domain_factory_baset> &&df,
+  std::unique_ptr<ai_storage_baset> &&st,
+  std::size_t number_of_threads)
+  : ai_baset(std::move(hf), std::move(df), std::move(st)),
+    number_of_threads(number_of_threads)
+{
+  PRECONDITION(
+    dynamic_cast<location_sensitive_storaget *>(storage.get()) != nullptr);
+  PRECONDITION(number_of_threads > 0);
+}
+
+void ai_parallel_interproceduralt::initialize(
+  const goto_functionst &goto_functions)
+{
+  ai_baset::initialize(goto_functions);
+
+  // Dropping states would modify the storage from several threads
+  PRECONDITION(!sparse_states);
+
+  // Create the states and the work lists of all functions now, so that
+  // analysing functions in parallel only looks up existing entries.
+  forall_goto_functions(f_it, goto_functions)
+  {
+    if(!f_it->second.body_available())
+      continue;
+
+    function_work[f_it->first];
+
+    forall_goto_program_instructions(i_it, f_it->second.body)
+      get_state(history_factory->epoch(i_it));
+  }
+}
+
+void ai_parallel_interproceduralt::fixedpoint(
+  trace_ptrt start_trace,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  if(start_trace == nullptr)
+    return;
+
+  function_work.at(goto_functions.entry_point())
+    .working_set.insert(start_trace);
+
+  std::vector<irep_idt> active;
+
+  while(true)
+  {
+    active.clear();
+    for(const auto &work : function_work)
+    {
+      if(!work.second.working_set.empty())
+        active.push_back(work.first);
+    }
+
+    if(active.empty())
+      break;
+
+#ifdef CPROVER_THREAD_SAFE
+    if(number_of_threads > 1 && active.size() > 1)
+    {
+      std::atomic<std::size_t> next(0);
+      std::vector<std::exception_ptr> exceptions(
+        std::min(number_of_threads, active.size()));
+      std::vector<std::thread> threads;
+
+      for(auto &exception : exceptions)
+      {
+        threads.emplace_back([&] {
+          try
+          {
+            for(std::size_t i = next++; i < active.size(); i = next++)
+              analyse_function(active[i], goto_functions, ns);
+          }
+          catch(...)
+          {
+            exception = std::current_exception();
+          }
+        });
+      }
+
+      for(auto &thread : threads)
+        thread.join();
+
+      for(const auto &exception : exceptions)
+      {
+        if(exception != nullptr)
+          std::rethrow_exception(exception);
+      }
+    }
+    else
+#endif
+    {
+      for(const auto &function_id : active)
+        analyse_function(function_id, goto_functions, ns);
+    }
+
+    for(const auto &function_id : active)
+      propagate(function_id, goto_functions, ns);
+  }
+}
+
+void ai_parallel_interproceduralt::analyse_function(
+  const irep_idt &function_id,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  function_workt &work = function_work.at(function_id);
+  const goto_programt &goto_program =
+    goto_functions.function_map.at(function_id).body;
+
+  while(!work.working_set.empty())
+  {
+    trace_ptrt p = get_next(work.working_set);
+    visit(function_id, p, work.working_set, goto_program, goto_functions, ns);
+  }
+}
+
+bool ai_parallel_interproceduralt::visit_edge_function_call(
+  const irep_idt &calling_function_id,
+  trace_ptrt p_call,
+  locationt l_return,
+  const irep_idt &callee_function_id,
+  working_sett &,
+  const goto_programt &,
+  const goto_functionst &,
+  const namespacet &)
+{
+  // The callee may be analysed by another thread at the moment
+  function_work.at(calling_function_id)
+    .calls.push_back(call_edget{p_call, l_return, callee_function_id});
+  return false;
+}
+
+bool ai_parallel_interproceduralt::visit_end_function(
+  const irep_idt &function_id,
+  trace_ptrt,
+  working_sett &,
+  const goto_programt &,
+  const goto_functionst &,
+  const namespacet &)
+{
+  function_work.at(function_id).end_reached = true;
+  return false;
+}
+
+void ai_parallel_interproceduralt::propagate(
+  const irep_idt &function_id,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  function_workt &work = function_work.at(function_id);
+
+  for(const auto &call : work.calls)
+  {
+    function_workt &callee_work = function_work.at(call.callee_function_id);
+    const goto_programt &callee =
+      goto_functions.function_map.at(call.callee_function_id).body;
+
+    // This is the edge from call site to function head.
+    visit_edge(
+      function_id,
+      call.p_call,
+      call.callee_function_id,
+      callee.instructions.begin(),
+      ns,
+      callee_work.working_set);
+
+    // A new return site gets the effect of the callee as computed so far
+    if(callee_work.return_site_set.insert(call.l_return).second)
+    {
+      callee_work.return_sites.emplace_back(function_id, call.l_return);
+      return_edges(
+        call.callee_function_id, callee, function_id, call.l_return, ns);
+    }
+  }
+
+  work.calls.clear();
+
+  if(work.end_reached)
+  {
+    const goto_programt &goto_program =
+      goto_functions.function_map.at(function_id).body;
+
+    for(const auto &return_site : work.return_sites)
+    {
+      return_edges(
+        function_id, goto_program, return_site.first, return_site.second, ns);
+    }
+
+    work.end_reached = false;
+  }
+}
+
+void ai_parallel_interproceduralt::return_edges(
+  const irep_idt &callee_function_id,
+  const goto_programt &callee,
+  const irep_idt &calling_function_id,
+  locationt l_return,
+  const namespacet &ns)
+{
+  locationt l_end = std::prev(callee.instructions.end());
+  DATA_INVARIANT(
+    l_end->is_end_function(),
+    "The last instruction of a goto_program must be END_FUNCTION");
+
+  working_sett &working_set = function_work.at(calling_function_id).working_set;
+
+  for(const auto &p_end : *storage->abstract_traces_before(l_end))
+  {
+    if(!get_state(p_end).is_bottom())
+    {
+      visit_edge(
+        callee_function_id,
+        p_end,
+        calling_function_id,
+        l_return,
+        ns,
+        working_set);
+    }
+  }
+}
@@ -48,11 +48,20 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#ifdef CPROVER_THREAD_SAFE
+#include <atomic>
+#include <mutex>
+#endif
 
 #include <util/json.h>
 #include <util/xml.h>
 #include <util/expr.h>
 #include <util/make_unique.h>
+#include <util/optional.h>
 
 #include <goto-programs/goto_model.h>
 
@@ -149,6 +158,7 @@ public:
     initialize(function_id, goto_program);
     trace_ptrt p = entry_state(goto_program);
     fixedpoint(p, function_id, goto_program, goto_functions, ns);
+    narrow(function_id, goto_program, goto_functions, ns);
     finalize();
   }
 
@@ -160,6 +170,7 @@ public:
     initialize(goto_functions);
     trace_ptrt p = entry_state(goto_functions);
     fixedpoint(p, goto_functions, ns);
+    narrow(goto_functions, ns);
     finalize();
   }
 
@@ -170,6 +181,7 @@ public:
     initialize(goto_model.get_goto_functions());
     trace_ptrt p = entry_state(goto_model.get_goto_functions());
     fixedpoint(p, goto_model.get_goto_functions(), ns);
+    narrow(goto_model.get_goto_functions(), ns);
     finalize();
   }
 
@@ -183,6 +195,26 @@ public:
     initialize(function_id, goto_function);
     trace_ptrt p = entry_state(goto_function.body);
     fixedpoint(p, function_id, goto_function.body, goto_functions, ns);
+    narrow(function_id, goto_function.body, goto_functions, ns);
+    finalize();
+  }
+
+  /// Run abstract interpretation on a function and the functions it calls,
+  /// starting from the entry state of the function rather than from that of
+  /// the whole program. The results hold whatever the calling context is.
+  /// Interpreters that only follow calls in their whole-program fixedpoint,
+  /// such as ai_parallel_interproceduralt, do not support this.
+  void operator()(
+    const irep_idt &function_id,
+    const goto_functionst &goto_functions,
+    const namespacet &ns)
+  {
+    const goto_programt &goto_program =
+      goto_functions.function_map.at(function_id).body;
+    initialize(goto_functions);
+    trace_ptrt p = entry_state(goto_program);
+    fixedpoint(p, function_id, goto_program, goto_functions, ns);
+    narrow(goto_functions, ns);
     finalize();
   }
 
@@ -220,6 +252,8 @@ public:
   ///   including merging abstract states, etc.
   virtual cstate_ptrt abstract_state_before(locationt l) const
   {
+    if(pruned_locations.find(l) != pruned_locations.end())
+      return recompute_state_before(l);
     return storage->abstract_state_before(l, *domain_factory);
   }
 
@@ -242,6 +276,8 @@ public:
   /// The same interfaces but with histories
   virtual cstate_ptrt abstract_state_before(const trace_ptrt &p) const
   {
+    if(pruned_locations.find(p->current_location()) != pruned_locations.end())
+      return recompute_state_before(p->current_location());
     return storage->abstract_state_before(p, *domain_factory);
   }
 
@@ -254,13 +290,56 @@ public:
 
     auto step_return = p->step(n, *(storage->abstract_traces_before(n)));
 
-    return storage->abstract_state_before(step_return.second, *domain_factory);
+    return abstract_state_before(step_return.second);
   }
 
   /// Reset the abstract state
   virtual void clear()
   {
     storage->clear();
+    widening_point_joins.clear();
+    pruned_locations.clear();
+    sparse_ns.reset();
+    steps = 0;
+  }
+
+  /// The number of locations taken from a work list, plus those recomputed
+  /// by narrowing, since the analysis has been cleared. This measures the
+  /// work the iteration strategy needs to reach its result.
+  std::size_t get_steps() const
+  {
+    return steps;
+  }
+
+  /// Widen rather than merge at loop heads, i.e., along backwards gotos,
+  /// once \p delay merges have been done at the loop head. This ensures
+  /// termination for domains of infinite height that support it (see
+  /// \ref ai_domain_factory_baset::widen). Widening is off by default.
+  void set_widening_delay(std::size_t delay)
+  {
+    widening_delay = delay;
+  }
+
+  /// After the fixed point has been reached, recompute the state of each
+  /// location from its predecessors \p passes times, in program order.
+  /// This recovers precision lost by widening. Requires one domain per
+  /// location (see \ref location_sensitive_storaget).
+  void set_narrowing_passes(std::size_t passes)
+  {
+    narrowing_passes = passes;
+  }
+
+  /// Only keep the abstract states at the entries and ends of functions, at
+  /// targets of gotos, and at function calls and their return sites. The
+  /// state of any other location, whose only predecessor is the previous
+  /// instruction, is dropped once it has been propagated and recomputed from
+  /// the nearest kept state when it is queried. This trades time for memory.
+  /// Requires one domain per location (see \ref location_sensitive_storaget)
+  /// and up-to-date target numbers (see \ref goto_programt::update), and is
+  /// not supported together with narrowing.
+  void set_sparse_states(bool sparse)
+  {
+    sparse_states = sparse;
   }
 
   /// Output the abstract states for a single function
@@ -493,9 +572,78 @@ protected:
   virtual bool merge(const statet &src, trace_ptrt from, trace_ptrt to)
   {
     statet &dest = get_state(to);
+    if(should_widen(from, to))
+      return domain_factory->widen(dest, src, from, to);
     return domain_factory->merge(dest, src, from, to);
   }
 
+  /// Number of merges at a widening point before widening, if enabled
+  optionalt<std::size_t> widening_delay;
+
+  std::size_t narrowing_passes = 0;
+
+  /// Number of merges done so far at each widening point
+  std::unordered_map<
+    locationt,
+    std::size_t,
+    const_target_hash,
+    pointee_address_equalt>
+    widening_point_joins;
+
+#ifdef CPROVER_THREAD_SAFE
+  std::mutex widening_point_joins_mutex;
+  std::atomic<std::size_t> steps{0};
+#else
+  std::size_t steps = 0;
+#endif
+
+  /// Whether the edge from \p from to \p to is a loop back edge that has
+  /// been merged into more than \ref widening_delay times. The widening
+  /// points are the targets of backwards gotos, not the heads of the
+  /// components of a weak topological ordering: as the work queue is sorted
+  /// by location, the locations of a loop are taken before those following
+  /// it, which for structured code is the order such an ordering would give.
+  bool should_widen(trace_ptrt from, trace_ptrt to);
+
+  /// Apply \ref narrowing_passes descending iterations to the states of
+  /// all functions
+  void narrow(const goto_functionst &goto_functions, const namespacet &ns);
+
+  /// Apply \ref narrowing_passes descending iterations to the states of
+  /// a single function. The states at the entry of the function and after
+  /// calls to functions with a body are kept, as they depend on other
+  /// functions.
+  void narrow(
+    const irep_idt &function_id,
+    const goto_programt &goto_program,
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  bool sparse_states = false;
+
+  /// The function of each location whose state has been dropped, see
+  /// \ref set_sparse_states
+  std::unordered_map<
+    locationt,
+    irep_idt,
+    const_target_hash,
+    pointee_address_equalt>
+    pruned_locations;
+
+  /// The namespace to recompute dropped states with
+  optionalt<namespacet> sparse_ns;
+
+  /// Whether the state at \p l may be dropped, see \ref set_sparse_states
+  static bool
+  is_prunable(locationt l, const goto_programt &goto_program);
+
+  /// Drop the state at \p l after it has been propagated
+  void prune(const irep_idt &function_id, locationt l, const namespacet &ns);
+
+  /// Recompute the dropped state before \p l by applying the transformers
+  /// from the nearest location with a kept state
+  cstate_ptrt recompute_state_before(locationt l) const;
+
   /// Make a copy of a state
   virtual std::unique_ptr<statet> make_temporary_state(const statet &s)
   {
@@ -539,6 +687,112 @@ protected:
     const namespacet &ns) override;
 };
 
+/// Context-insensitive interprocedural analysis that analyses functions in
+/// parallel. Each function has its own work list; the fixed point is computed
+/// in rounds, where first all functions with pending work are analysed
+/// independently (in parallel when built with CPROVER_THREAD_SAFE), and then
+/// the edges between functions, i.e., from call sites to the entry of the
+/// callee and from the end of the callee to all return sites reached so far,
+/// are processed sequentially to schedule the next round.
+/// As the states of all locations are created up front and only the thread
+/// analysing a function touches the states of that function, this requires
+/// one domain per location (see \ref location_sensitive_storaget).
+class ai_parallel_interproceduralt : public ai_baset
+{
+public:
+  /// \param hf: the history factory
+  /// \param df: the domain factory
+  /// \param st: the storage, which must be a location_sensitive_storaget
+  /// \param number_of_threads: maximum number of functions that are analysed
+  ///   at the same time
+  ai_parallel_interproceduralt(
+    std::unique_ptr<ai_history_factory_baset> &&hf,
+    std::unique_ptr<ai_domain_factory_baset> &&df,
+    std::unique_ptr<ai_storage_baset> &&st,
+    std::size_t number_of_threads);
+
+  void clear() override
+  {
+    ai_baset::clear();
+    function_work.clear();
+  }
+
+protected:
+  void initialize(const goto_functionst &goto_functions) override;
+
+  void fixedpoint(
+    trace_ptrt start_trace,
+    const goto_functionst &goto_functions,
+    const namespacet &ns) override;
+
+  // Calls and returns are recorded while a function is analysed,
+  // and processed once all functions of the round are done
+  bool visit_edge_function_call(
+    const irep_idt &calling_function_id,
+    trace_ptrt p_call,
+    locationt l_return,
+    const irep_idt &callee_function_id,
+    working_sett &working_set,
+    const goto_programt &callee,
+    const goto_functionst &goto_functions,
+    const namespacet &ns) override;
+
+  bool visit_end_function(
+    const irep_idt &function_id,
+    trace_ptrt p,
+    working_sett &working_set,
+    const goto_programt &goto_program,
+    const goto_functionst &goto_functions,
+    const namespacet &ns) override;
+
+  struct call_edget
+  {
+    trace_ptrt p_call;
+    locationt l_return;
+    irep_idt callee_function_id;
+  };
+
+  struct function_workt
+  {
+    /// Histories in this function that need to be visited
+    working_sett working_set;
+    /// Calls made by this function in the current round
+    std::vector<call_edget> calls;
+    /// Whether the end of this function was reached in the current round
+    bool end_reached = false;
+    /// The return sites of all calls to this function reached so far
+    std::vector<std::pair<irep_idt, locationt>> return_sites;
+    std::unordered_set<locationt, const_target_hash, pointee_address_equalt>
+      return_site_set;
+  };
+
+  /// Work per function with a body, populated by initialize, such that the
+  /// map is not modified while functions are analysed in parallel
+  std::map<irep_idt, function_workt> function_work;
+
+  const std::size_t number_of_threads;
+
+  /// Run the fixed point of \p function_id on the pending histories
+  void analyse_function(
+    const irep_idt &function_id,
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  /// Process the calls and returns of \p function_id recorded in this round
+  void propagate(
+    const irep_idt &function_id,
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  /// Do the edges from the end of \p callee_function_id to \p l_return
+  void return_edges(
+    const irep_idt &callee_function_id,
+    const goto_programt &callee,
+    const irep_idt &calling_function_id,
+    locationt l_return,
+    const namespacet &ns);
+};
+
 /// ait supplies three of the four components needed: an abstract interpreter
 /// (in this case handling function calls via recursion), a history factory
 /// (using the simplest possible history objects) and storage (one domain per
@@ -203,6 +203,16 @@ public:
   virtual bool
   merge(statet &dest, const statet &src, trace_ptrt from, trace_ptrt to)
     const = 0;
+
+  /// Used instead of merge at widening points (see
+  /// \ref ai_baset::set_widening_delay). Domains of infinite height should
+  /// over-approximate the join such that no infinite ascending chains are
+  /// possible; the default is to merge.
+  virtual bool
+  widen(statet &dest, const statet &src, trace_ptrt from, trace_ptrt to) const
+  {
+    return merge(dest, src, from, to);
+  }
 };
 // Converting make to take a trace_ptr instead of a location would
 // require removing the backwards-compatible
@@ -216,6 +216,13 @@ public:
     state_map.clear();
     return;
   }
+
+  /// Drops the domain, the abstract interpreter recomputes it when queried
+  /// (see ai_baset::set_sparse_states)
+  void prune(locationt l) override
+  {
+    state_map.erase(l);
+  }
 };
 
 // The most precise form of storage
@@ -0,0 +1,527 @@
+/*******************************************************************\
+
+Module: Demand-driven points-to analysis
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Flow-, context- and field-insensitive points-to analysis that only
+/// computes the points-to sets that are actually queried
+
+#include "demand_driven_points_to.h"
+
+#include <util/byte_operators.h>
+#include <util/expr_iterator.h>
+#include <util/expr_util.h>
+#include <util/namespace.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+#include <util/symbol.h>
+
+#include <goto-programs/goto_functions.h>
+
+static irep_idt return_value_id(const irep_idt &function_id)
+{
+  return id2string(function_id) + "#return_value";
+}
+
+/// \return true if values of type \p type may be or contain pointers; the
+///   members and elements of structs, unions and arrays are summarised
+static bool may_hold_pointers(const typet &type)
+{
+  const irep_idt &id = type.id();
+  return id == ID_pointer || id == ID_struct || id == ID_struct_tag ||
+         id == ID_union || id == ID_union_tag || id == ID_array ||
+         id == ID_vector;
+}
+
+/// Add the symbols whose address is taken by `&object` to \p dest
+static void address_roots(
+  const exprt &object,
+  std::unordered_set<irep_idt> &dest)
+{
+  if(object.id() == ID_symbol)
+    dest.insert(to_symbol_expr(object).get_identifier());
+  else if(object.id() == ID_member)
+    address_roots(to_member_expr(object).struct_op(), dest);
+  else if(object.id() == ID_index)
+    address_roots(to_index_expr(object).array(), dest);
+  else if(object.id() == ID_if)
+  {
+    address_roots(to_if_expr(object).true_case(), dest);
+    address_roots(to_if_expr(object).false_case(), dest);
+  }
+  else if(object.id() == ID_typecast)
+    address_roots(to_typecast_expr(object).op(), dest);
+  else if(
+    object.id() == ID_byte_extract_little_endian ||
+    object.id() == ID_byte_extract_big_endian)
+  {
+    address_roots(to_byte_extract_expr(object).op(), dest);
+  }
+}
+
+demand_driven_points_tot::demand_driven_points_tot(
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+  : ns(ns)
+{
+  collect(goto_functions);
+}
+
+void demand_driven_points_tot::collect_address_taken(const exprt &expr)
+{
+  for(auto it = expr.depth_cbegin(); it != expr.depth_cend(); ++it)
+  {
+    if(it->id() == ID_address_of)
+      address_roots(to_address_of_expr(*it).object(), address_taken);
+  }
+}
+
+void demand_driven_points_tot::add_assignment(
+  const exprt &lhs,
+  const exprt &rhs)
+{
+  if(lhs.id() == ID_symbol)
+    assignments[to_symbol_expr(lhs).get_identifier()].push_back(rhs);
+  else if(lhs.id() == ID_member)
+    add_assignment(to_member_expr(lhs).struct_op(), rhs);
+  else if(lhs.id() == ID_index)
+  {
+    const exprt &array = to_index_expr(lhs).array();
+    if(array.type().id() == ID_pointer)
+      stores.emplace_back(array, rhs);
+    else
+      add_assignment(array, rhs);
+  }
+  else if(lhs.id() == ID_dereference)
+    stores.emplace_back(to_dereference_expr(lhs).pointer(), rhs);
+  else if(lhs.id() == ID_if)
+  {
+    add_assignment(to_if_expr(lhs).true_case(), rhs);
+    add_assignment(to_if_expr(lhs).false_case(), rhs);
+  }
+  else if(lhs.id() == ID_typecast)
+    add_assignment(to_typecast_expr(lhs).op(), rhs);
+  else if(
+    lhs.id() == ID_byte_extract_little_endian ||
+    lhs.id() == ID_byte_extract_big_endian)
+  {
+    add_assignment(to_byte_extract_expr(lhs).op(), rhs);
+  }
+  else if(lhs.id() == ID_complex_real || lhs.id() == ID_complex_imag)
+    add_assignment(to_unary_expr(lhs).op(), rhs);
+  else
+    all_unknown = true;
+}
+
+void demand_driven_points_tot::collect(const goto_functionst &goto_functions)
+{
+  std::vector<exprt::operandst> indirect_call_arguments;
+
+  forall_goto_functions(f_it, goto_functions)
+  {
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      i_it->apply([this](const exprt &expr) { collect_address_taken(expr); });
+
+      if(i_it->is_assign())
+        add_assignment(i_it->get_assign().lhs(), i_it->get_assign().rhs());
+      else if(i_it->is_return())
+      {
+        const code_returnt &code_return = i_it->get_return();
+        if(code_return.has_return_value())
+        {
+          assignments[return_value_id(f_it->first)].push_back(
+            code_return.return_value());
+        }
+      }
+      else if(i_it->is_function_call())
+      {
+        const code_function_callt &call = i_it->get_function_call();
+        const exprt &lhs = call.lhs();
+
+        if(call.function().id() != ID_symbol)
+        {
+          // the arguments are passed on below, once all functions whose
+          // address is taken are known
+          indirect_call_arguments.push_back(call.arguments());
+          if(lhs.is_not_nil())
+          {
+            add_assignment(
+              lhs,
+              side_effect_expr_nondett(lhs.type(), call.source_location()));
+          }
+          continue;
+        }
+
+        const irep_idt &callee =
+          to_symbol_expr(call.function()).get_identifier();
+        const auto callee_it = goto_functions.function_map.find(callee);
+
+        if(
+          callee_it != goto_functions.function_map.end() &&
+          callee_it->second.body_available())
+        {
+          const auto &parameters = callee_it->second.parameter_identifiers;
+          for(std::size_t i = 0;
+              i < parameters.size() && i < call.arguments().size();
+              ++i)
+          {
+            if(!parameters[i].empty())
+              assignments[parameters[i]].push_back(call.arguments()[i]);
+          }
+
+          if(lhs.is_not_nil())
+          {
+            add_assignment(
+              lhs, symbol_exprt(return_value_id(callee), lhs.type()));
+          }
+        }
+        else
+        {
+          for(const auto &argument : call.arguments())
+            escaped.push_back(argument);
+          if(lhs.is_not_nil())
+          {
+            add_assignment(
+              lhs,
+              side_effect_expr_nondett(lhs.type(), call.source_location()));
+          }
+        }
+      }
+      else if(i_it->is_other())
+      {
+        const irep_idt &statement = i_it->code.get_statement();
+        if(statement == ID_asm)
+          all_unknown = true;
+        else if(
+          statement != ID_expression && statement != ID_printf &&
+          statement != ID_input && statement != ID_output &&
+          statement != ID_fence)
+        {
+          // array_set, array_copy, havoc_object and the like
+          for(const auto &op : i_it->code.operands())
+            escaped.push_back(op);
+        }
+      }
+    }
+  }
+
+  if(indirect_call_arguments.empty())
+    return;
+
+  // an indirect call may reach any function whose address is taken
+  bool arguments_escape = false;
+  for(const auto &object : address_taken)
+  {
+    const symbolt *symbol;
+    if(ns.lookup(object, symbol) || symbol->type.id() != ID_code)
+      continue;
+
+    const auto f_it = goto_functions.function_map.find(object);
+    if(
+      f_it == goto_functions.function_map.end() ||
+      !f_it->second.body_available())
+    {
+      arguments_escape = true;
+      continue;
+    }
+
+    const auto &parameters = f_it->second.parameter_identifiers;
+    for(const auto &arguments : indirect_call_arguments)
+    {
+      for(std::size_t i = 0; i < parameters.size() && i < arguments.size();
+          ++i)
+      {
+        if(!parameters[i].empty())
+          assignments[parameters[i]].push_back(arguments[i]);
+      }
+    }
+  }
+
+  if(arguments_escape)
+  {
+    for(const auto &arguments : indirect_call_arguments)
+      escaped.insert(escaped.end(), arguments.begin(), arguments.end());
+  }
+}
+
+const demand_driven_points_tot::sett &
+demand_driven_points_tot::lookup(const irep_idt &identifier)
+{
+  const auto cache_entry = cache.find(identifier);
+  if(cache_entry != cache.end())
+    return cache_entry->second;
+
+  const auto pending_entry = pending.emplace(identifier, sett());
+  if(pending_entry.second)
+    pending_order.push_back(identifier);
+
+  return pending_entry.first->second;
+}
+
+void demand_driven_points_tot::solve()
+{
+  // Chaotic iteration over all symbols the queries depend on; symbols
+  // discovered while evaluating are added to the end of pending_order and
+  // thus evaluated in the same round.
+  bool changed = true;
+  while(changed)
+  {
+    changed = false;
+    for(std::size_t i = 0; i < pending_order.size(); ++i)
+    {
+      const irep_idt identifier = pending_order[i];
+      sett result = compute(identifier);
+      sett &dest = pending.at(identifier);
+      if(!(result == dest))
+      {
+        dest = std::move(result);
+        changed = true;
+      }
+    }
+  }
+
+  for(auto &entry : pending)
+    cache.emplace(entry.first, std::move(entry.second));
+
+  pending.clear();
+  pending_order.clear();
+}
+
+demand_driven_points_tot::sett
+demand_driven_points_tot::compute(const irep_idt &identifier)
+{
+  sett result;
+
+  if(all_unknown)
+  {
+    result.unknown = true;
+    return result;
+  }
+
+  const auto assignments_entry = assignments.find(identifier);
+  if(assignments_entry != assignments.end())
+  {
+    for(const auto &rhs : assignments_entry->second)
+      evaluate(rhs, result);
+  }
+
+  // only objects whose address is taken can be changed through pointers
+  if(
+    result.unknown ||
+    (identifier != ID_dynamic_object &&
+     address_taken.find(identifier) == address_taken.end()))
+  {
+    return result;
+  }
+
+  for(const auto &store : stores)
+  {
+    sett targets;
+    evaluate(store.first, targets);
+    if(targets.unknown || targets.objects.count(identifier) != 0)
+      evaluate(store.second, result);
+  }
+
+  for(const auto &pointer : escaped)
+  {
+    if(result.unknown)
+      break;
+    if(may_reach(pointer, identifier))
+      result.unknown = true;
+  }
+
+  return result;
+}
+
+void demand_driven_points_tot::evaluate(const exprt &expr, sett &dest)
+{
+  if(dest.unknown)
+    return;
+
+  if(expr.id() == ID_symbol)
+  {
+    const irep_idt &identifier = to_symbol_expr(expr).get_identifier();
+
+    // function designator
+    if(expr.type().id() == ID_code)
+    {
+      dest.objects.insert(identifier);
+      return;
+    }
+
+    const sett &value = lookup(identifier);
+    dest.unknown |= value.unknown;
+    dest.objects.insert(value.objects.begin(), value.objects.end());
+  }
+  else if(expr.id() == ID_address_of)
+    objects_of(to_address_of_expr(expr).object(), dest);
+  else if(expr.id() == ID_dereference)
+  {
+    sett pointers;
+    evaluate(to_dereference_expr(expr).pointer(), pointers);
+    if(pointers.unknown)
+    {
+      dest.unknown = true;
+      return;
+    }
+
+    for(const auto &object : pointers.objects)
+    {
+      const sett &value = lookup(object);
+      dest.unknown |= value.unknown;
+      dest.objects.insert(value.objects.begin(), value.objects.end());
+    }
+  }
+  else if(expr.id() == ID_constant)
+  {
+    // a pointer constant other than NULL comes from an integer
+    if(expr.type().id() == ID_pointer && !expr.is_zero())
+      dest.unknown = true;
+  }
+  else if(expr.id() == ID_typecast)
+  {
+    const exprt &op = to_typecast_expr(expr).op();
+    if(expr.type().id() == ID_pointer && op.type().id() != ID_pointer)
+    {
+      // any integer other than NULL converted to a pointer may point anywhere
+      if(!op.is_zero())
+        dest.unknown = true;
+    }
+    else
+      evaluate(op, dest);
+  }
+  else if(expr.id() == ID_if)
+  {
+    evaluate(to_if_expr(expr).true_case(), dest);
+    evaluate(to_if_expr(expr).false_case(), dest);
+  }
+  else if(expr.id() == ID_index)
+  {
+    const exprt &array = to_index_expr(expr).array();
+    if(array.type().id() == ID_pointer)
+      evaluate(dereference_exprt(array), dest);
+    else
+      evaluate(array, dest);
+  }
+  else if(expr.id() == ID_side_effect)
+  {
+    if(to_side_effect_expr(expr).get_statement() == ID_allocate)
+      dest.objects.insert(ID_dynamic_object);
+    else
+      dest.unknown = true;
+  }
+  else if(expr.id() == ID_nondet_symbol)
+    dest.unknown = true;
+  else
+  {
+    // members, pointer arithmetic, struct and array constructors: the union
+    // of the values of the operands that may hold pointers
+    for(const auto &op : expr.operands())
+    {
+      if(may_hold_pointers(op.type()))
+        evaluate(op, dest);
+    }
+  }
+}
+
+void demand_driven_points_tot::objects_of(const exprt &object, sett &dest)
+{
+  if(object.id() == ID_symbol)
+    dest.objects.insert(to_symbol_expr(object).get_identifier());
+  else if(object.id() == ID_member)
+    objects_of(to_member_expr(object).struct_op(), dest);
+  else if(object.id() == ID_index)
+  {
+    const exprt &array = to_index_expr(object).array();
+    if(array.type().id() == ID_pointer)
+      evaluate(array, dest);
+    else
+      objects_of(array, dest);
+  }
+  else if(object.id() == ID_dereference)
+    evaluate(to_dereference_expr(object).pointer(), dest);
+  else if(object.id() == ID_if)
+  {
+    objects_of(to_if_expr(object).true_case(), dest);
+    objects_of(to_if_expr(object).false_case(), dest);
+  }
+  else if(object.id() == ID_typecast)
+    objects_of(to_typecast_expr(object).op(), dest);
+  else if(
+    object.id() == ID_byte_extract_little_endian ||
+    object.id() == ID_byte_extract_big_endian)
+  {
+    objects_of(to_byte_extract_expr(object).op(), dest);
+  }
+  else if(
+    object.id() == ID_string_constant || object.id() == ID_constant ||
+    object.id() == ID_array || object.id() == ID_struct ||
+    object.id() == ID_array_of)
+  {
+    // constant objects that never contain pointers we could follow
+    dest.objects.insert(object.id());
+  }
+  else
+    dest.unknown = true;
+}
+
+bool demand_driven_points_tot::may_reach(
+  const exprt &pointer,
+  const irep_idt &identifier)
+{
+  sett start;
+  evaluate(pointer, start);
+  if(start.unknown)
+    return true;
+
+  std::unordered_set<irep_idt> seen;
+  std::vector<irep_idt> todo(start.objects.begin(), start.objects.end());
+
+  while(!todo.empty())
+  {
+    const irep_idt object = todo.back();
+    todo.pop_back();
+
+    if(object == identifier)
+      return true;
+    if(!seen.insert(object).second)
+      continue;
+
+    const sett &value = lookup(object);
+    if(value.unknown)
+      return true;
+    todo.insert(todo.end(), value.objects.begin(), value.objects.end());
+  }
+
+  return false;
+}
+
+demand_driven_points_tot::sett demand_driven_points_tot::
+operator()(const exprt &pointer)
+{
+  sett result;
+
+  // evaluating the expression may require points-to sets that have not been
+  // computed yet
+  do
+  {
+    solve();
+    result = sett();
+    evaluate(pointer, result);
+  } while(!pending.empty());
+
+  return result;
+}
+
+const demand_driven_points_tot::sett &
+demand_driven_points_tot::points_to(const irep_idt &identifier)
+{
+  lookup(identifier);
+  solve();
+  return cache.at(identifier);
+}
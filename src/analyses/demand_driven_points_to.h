@@ -0,0 +1,109 @@
+/*******************************************************************\
+
+Module: Demand-driven points-to analysis
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Flow-, context- and field-insensitive points-to analysis that only
+/// computes the points-to sets that are actually queried
+
+#ifndef CPROVER_ANALYSES_DEMAND_DRIVEN_POINTS_TO_H
+#define CPROVER_ANALYSES_DEMAND_DRIVEN_POINTS_TO_H
+
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <util/expr.h>
+
+class goto_functionst;
+class namespacet;
+
+/// Answers "what may this pointer point to" for pointers anywhere in a
+/// program. Building the analysis only collects the assignment graph of the
+/// program: the expressions assigned to each symbol (including parameter
+/// passing and return values) and the assignments through pointers. A query
+/// then evaluates only the part of the graph the queried pointer depends on,
+/// to a fixed point, and caches the points-to sets of all symbols involved
+/// for later queries.
+///
+/// The analysis is flow-, context- and field-insensitive: the contents of
+/// all members and elements of an object are summarised in one set, and all
+/// dynamically allocated memory is a single object. Whenever a value may
+/// come from outside the program as seen by the analysis (nondeterministic
+/// values, integers cast to pointers, functions without body, inline
+/// assembly), the result is "unknown" rather than an under-approximation.
+class demand_driven_points_tot
+{
+public:
+  /// A set of objects, given by the identifier of their symbol
+  struct sett
+  {
+    /// May point to any object
+    bool unknown = false;
+    std::set<irep_idt> objects;
+
+    bool operator==(const sett &other) const
+    {
+      return unknown == other.unknown && objects == other.objects;
+    }
+  };
+
+  demand_driven_points_tot(
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  /// \return the objects the value of \p pointer, evaluated at any location
+  ///   of the program, may point to
+  sett operator()(const exprt &pointer);
+
+  /// \return the objects the value of the symbol \p identifier may point to
+  const sett &points_to(const irep_idt &identifier);
+
+protected:
+  const namespacet &ns;
+
+  /// Expressions assigned to each symbol, including arguments passed to
+  /// parameters and return values (to `function#return_value`)
+  std::unordered_map<irep_idt, std::vector<exprt>> assignments;
+
+  /// Assignments through pointers: the pointer and the assigned value
+  std::vector<std::pair<exprt, exprt>> stores;
+
+  /// Pointers passed to code the analysis does not see, which may write
+  /// anything to the objects reachable from them
+  std::vector<exprt> escaped;
+
+  /// Objects whose address is taken, the only ones that assignments through
+  /// pointers can change
+  std::unordered_set<irep_idt> address_taken;
+
+  /// Set if the program contains code the analysis cannot model at all
+  bool all_unknown = false;
+
+  /// Points-to sets of symbols that have been computed completely
+  std::unordered_map<irep_idt, sett> cache;
+
+  /// Points-to sets that are being computed by the current query, and the
+  /// order in which they are (re-)evaluated
+  std::unordered_map<irep_idt, sett> pending;
+  std::vector<irep_idt> pending_order;
+
+  void collect(const goto_functionst &goto_functions);
+  void collect_address_taken(const exprt &expr);
+  void add_assignment(const exprt &lhs, const exprt &rhs);
+
+  const sett &lookup(const irep_idt &identifier);
+  void solve();
+  sett compute(const irep_idt &identifier);
+  void evaluate(const exprt &expr, sett &dest);
+  void objects_of(const exprt &object, sett &dest);
+  bool may_reach(const exprt &pointer, const irep_idt &identifier);
+};
+
+#endif // CPROVER_ANALYSES_DEMAND_DRIVEN_POINTS_TO_H
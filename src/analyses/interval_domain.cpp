@@ -20,19 +20,33 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/std_expr.h>
 #include <util/arith_tools.h>
 
-void interval_domaint::output(
-  std::ostream &out,
-  const ai_baset &,
-  const namespacet &) const
-{
-  if(bottom)
-  {
-    out << "BOTTOM\n";
-    return;
-  }
+#include <algorithm>
+#include <utility>
+#include <vector>
 
-  for(const auto &interval : int_map)
+/// Output the non-trivial intervals of \p map, ordered like the identifiers
+template <class mapt>
+static void output_map(std::ostream &out, const mapt &map)
+{
+  typename mapt::viewt view;
+  map.get_view(view);
+
+  // view items are references, hence sort pointers to them
+  std::vector<const typename mapt::view_itemt *> sorted;
+  sorted.reserve(view.size());
+  for(const auto &item : view)
+    sorted.push_back(&item);
+  std::sort(
+    sorted.begin(),
+    sorted.end(),
+    [](
+      const typename mapt::view_itemt *a, const typename mapt::view_itemt *b) {
+      return a->first < b->first;
+    });
+
+  for(const auto item : sorted)
   {
+    const auto &interval = *item;
     if(interval.second.is_top())
       continue;
     if(interval.second.lower_set)
@@ -42,18 +56,89 @@ void interval_domaint::output(
       out << " <= " << interval.second.upper;
     out << "\n";
   }
+}
 
-  for(const auto &interval : float_map)
+/// The interval of \p identifier in \p map, top if there is none
+template <class mapt>
+static typename mapt::mapped_type
+get_interval(const mapt &map, const irep_idt &identifier)
+{
+  const auto entry = map.find(identifier);
+  if(!entry.has_value())
+    return typename mapt::mapped_type();
+  return entry->get();
+}
+
+/// Set the interval of \p identifier in \p map. Top intervals are not
+/// stored, and unchanged intervals are not replaced so as not to break
+/// sharing.
+template <class mapt>
+static void set_interval(
+  mapt &map,
+  const irep_idt &identifier,
+  const typename mapt::mapped_type &interval)
+{
+  const auto entry = map.find(identifier);
+  if(!entry.has_value())
   {
-    if(interval.second.is_top())
+    if(!interval.is_top())
+      map.insert(identifier, interval);
+  }
+  else if(interval.is_top())
+    map.erase(identifier);
+  else if(entry->get() != interval)
+    map.replace(identifier, interval);
+}
+
+/// Combine the intervals of \p map with those of \p b_map using \p combine,
+/// which updates its first argument and returns whether it changed. Variables
+/// without an interval in \p b_map become unconstrained.
+/// \return True if \p map changed
+template <class mapt, class combinet>
+static bool combine_map(mapt &map, const mapt &b_map, combinet combine)
+{
+  // Only the parts that are not shared between the maps can differ
+  typename mapt::delta_viewt delta_view;
+  map.get_delta_view(b_map, delta_view, false);
+
+  std::vector<irep_idt> erased;
+  std::vector<std::pair<irep_idt, typename mapt::mapped_type>> changed;
+
+  for(const auto &entry : delta_view)
+  {
+    if(!entry.is_in_both_maps())
+    {
+      erased.push_back(entry.k);
       continue;
-    if(interval.second.lower_set)
-      out << interval.second.lower << " <= ";
-    out << interval.first;
-    if(interval.second.upper_set)
-      out << " <= " << interval.second.upper;
-    out << "\n";
+    }
+
+    typename mapt::mapped_type interval = entry.m;
+    if(combine(interval, entry.get_other_map_value()))
+      changed.emplace_back(entry.k, interval);
   }
+
+  // The delta view refers to the map, so only modify it now
+  for(const auto &identifier : erased)
+    map.erase(identifier);
+  for(const auto &change : changed)
+    set_interval(map, change.first, change.second);
+
+  return !erased.empty() || !changed.empty();
+}
+
+void interval_domaint::output(
+  std::ostream &out,
+  const ai_baset &,
+  const namespacet &) const
+{
+  if(bottom)
+  {
+    out << "BOTTOM\n";
+    return;
+  }
+
+  output_map(out, int_map);
+  output_map(out, float_map);
 }
 
 void interval_domaint::transform(
@@ -159,51 +244,48 @@ bool interval_domaint::join(
     return true;
   }
 
-  bool result=false;
-
-  for(int_mapt::iterator it=int_map.begin();
-      it!=int_map.end(); ) // no it++
-  {
-    // search for the variable that needs to be merged
-    // containers have different size and variable order
-    const int_mapt::const_iterator b_it=b.int_map.find(it->first);
-    if(b_it==b.int_map.end())
-    {
-      it=int_map.erase(it);
-      result=true;
-    }
-    else
-    {
-      integer_intervalt previous=it->second;
-      it->second.join(b_it->second);
-      if(it->second!=previous)
-        result=true;
-
-      it++;
-    }
-  }
+  const bool int_result = combine_map(
+    int_map,
+    b.int_map,
+    [](integer_intervalt &interval, const integer_intervalt &b_interval) {
+      const integer_intervalt previous = interval;
+      interval.join(b_interval);
+      return interval != previous;
+    });
+  const bool float_result = combine_map(
+    float_map,
+    b.float_map,
+    [](ieee_float_intervalt &interval, const ieee_float_intervalt &b_interval) {
+      const ieee_float_intervalt previous = interval;
+      interval.join(b_interval);
+      return interval != previous;
+    });
+  return int_result || float_result;
+}
 
-  for(float_mapt::iterator it=float_map.begin();
-      it!=float_map.end(); ) // no it++
+bool interval_domaint::widen(const interval_domaint &b)
+{
+  if(b.bottom)
+    return false;
+  if(bottom)
   {
-    const float_mapt::const_iterator b_it=b.float_map.begin();
-    if(b_it==b.float_map.end())
-    {
-      it=float_map.erase(it);
-      result=true;
-    }
-    else
-    {
-      ieee_float_intervalt previous=it->second;
-      it->second.join(b_it->second);
-      if(it->second!=previous)
-        result=true;
-
-      it++;
-    }
+    *this = b;
+    return true;
   }
 
-  return result;
+  const bool int_result = combine_map(
+    int_map,
+    b.int_map,
+    [](integer_intervalt &interval, const integer_intervalt &b_interval) {
+      return interval.widen_with(b_interval);
+    });
+  const bool float_result = combine_map(
+    float_map,
+    b.float_map,
+    [](ieee_float_intervalt &interval, const ieee_float_intervalt &b_interval) {
+      return interval.widen_with(b_interval);
+    });
+  return int_result || float_result;
 }
 
 void interval_domaint::assign(const code_assignt &code_assign)
@@ -224,9 +306,9 @@ void interval_domaint::havoc_rec(const exprt &lhs)
     irep_idt identifier=to_symbol_expr(lhs).get_identifier();
 
     if(is_int(lhs.type()))
-      int_map.erase(identifier);
+      int_map.erase_if_exists(identifier);
     else if(is_float(lhs.type()))
-      float_map.erase(identifier);
+      float_map.erase_if_exists(identifier);
   }
   else if(lhs.id()==ID_typecast)
   {
@@ -279,8 +361,9 @@ void interval_domaint::assume_rec(
       mp_integer tmp = numeric_cast_v<mp_integer>(to_constant_expr(rhs));
       if(id==ID_lt)
         --tmp;
-      integer_intervalt &ii=int_map[lhs_identifier];
+      integer_intervalt ii = get_interval(int_map, lhs_identifier);
       ii.make_le_than(tmp);
+      set_interval(int_map, lhs_identifier, ii);
       if(ii.is_bottom())
         make_bottom();
     }
@@ -289,8 +372,9 @@ void interval_domaint::assume_rec(
       ieee_floatt tmp(to_constant_expr(rhs));
       if(id==ID_lt)
         tmp.decrement();
-      ieee_float_intervalt &fi=float_map[lhs_identifier];
+      ieee_float_intervalt fi = get_interval(float_map, lhs_identifier);
       fi.make_le_than(tmp);
+      set_interval(float_map, lhs_identifier, fi);
       if(fi.is_bottom())
         make_bottom();
     }
@@ -304,8 +388,9 @@ void interval_domaint::assume_rec(
       mp_integer tmp = numeric_cast_v<mp_integer>(to_constant_expr(lhs));
       if(id==ID_lt)
         ++tmp;
-      integer_intervalt &ii=int_map[rhs_identifier];
+      integer_intervalt ii = get_interval(int_map, rhs_identifier);
       ii.make_ge_than(tmp);
+      set_interval(int_map, rhs_identifier, ii);
       if(ii.is_bottom())
         make_bottom();
     }
@@ -314,8 +399,9 @@ void interval_domaint::assume_rec(
       ieee_floatt tmp(to_constant_expr(lhs));
       if(id==ID_lt)
         tmp.increment();
-      ieee_float_intervalt &fi=float_map[rhs_identifier];
+      ieee_float_intervalt fi = get_interval(float_map, rhs_identifier);
       fi.make_ge_than(tmp);
+      set_interval(float_map, rhs_identifier, fi);
       if(fi.is_bottom())
         make_bottom();
     }
@@ -327,20 +413,20 @@ void interval_domaint::assume_rec(
 
     if(is_int(lhs.type()) && is_int(rhs.type()))
     {
-      integer_intervalt &lhs_i=int_map[lhs_identifier];
-      integer_intervalt &rhs_i=int_map[rhs_identifier];
-      lhs_i.meet(rhs_i);
-      rhs_i=lhs_i;
-      if(rhs_i.is_bottom())
+      integer_intervalt lhs_i = get_interval(int_map, lhs_identifier);
+      lhs_i.meet(get_interval(int_map, rhs_identifier));
+      set_interval(int_map, lhs_identifier, lhs_i);
+      set_interval(int_map, rhs_identifier, lhs_i);
+      if(lhs_i.is_bottom())
         make_bottom();
     }
     else if(is_float(lhs.type()) && is_float(rhs.type()))
     {
-      ieee_float_intervalt &lhs_i=float_map[lhs_identifier];
-      ieee_float_intervalt &rhs_i=float_map[rhs_identifier];
-      lhs_i.meet(rhs_i);
-      rhs_i=lhs_i;
-      if(rhs_i.is_bottom())
+      ieee_float_intervalt lhs_i = get_interval(float_map, lhs_identifier);
+      lhs_i.meet(get_interval(float_map, rhs_identifier));
+      set_interval(float_map, lhs_identifier, lhs_i);
+      set_interval(float_map, rhs_identifier, lhs_i);
+      if(lhs_i.is_bottom())
         make_bottom();
     }
   }
@@ -403,11 +489,11 @@ exprt interval_domaint::make_expression(const symbol_exprt &src) const
 {
   if(is_int(src.type()))
   {
-    int_mapt::const_iterator i_it=int_map.find(src.get_identifier());
-    if(i_it==int_map.end())
+    const auto entry = int_map.find(src.get_identifier());
+    if(!entry.has_value())
       return true_exprt();
 
-    const integer_intervalt &interval=i_it->second;
+    const integer_intervalt &interval = entry->get();
     if(interval.is_top())
       return true_exprt();
     if(interval.is_bottom())
@@ -431,11 +517,11 @@ exprt interval_domaint::make_expression(const symbol_exprt &src) const
   }
   else if(is_float(src.type()))
   {
-    float_mapt::const_iterator i_it=float_map.find(src.get_identifier());
-    if(i_it==float_map.end())
+    const auto entry = float_map.find(src.get_identifier());
+    if(!entry.has_value())
       return true_exprt();
 
-    const ieee_float_intervalt &interval=i_it->second;
+    const ieee_float_intervalt &interval = entry->get();
     if(interval.is_top())
       return true_exprt();
     if(interval.is_bottom())
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/ieee_float.h>
 #include <util/integer_interval.h>
 #include <util/interval_template.h>
+#include <util/sharing_map.h>
 
 #include "ai.h"
 
@@ -48,6 +49,11 @@ protected:
   bool join(const interval_domaint &b);
 
 public:
+  /// Like join, but any bound that \p b exceeds is dropped rather than
+  /// extended, which ensures termination of the analysis of loops
+  /// \return True if the widening changes *this
+  bool widen(const interval_domaint &b);
+
   bool merge(
     const interval_domaint &b,
     locationt,
@@ -114,8 +120,13 @@ public:
 protected:
   bool bottom;
 
-  typedef std::map<irep_idt, integer_intervalt> int_mapt;
-  typedef std::map<irep_idt, ieee_float_intervalt> float_mapt;
+  // Variables that are not in the maps are unconstrained. Sharing maps are
+  // used as most of the state is the same at neighbouring locations, which
+  // also allows joins to skip the shared parts.
+  typedef sharing_mapt<irep_idt, integer_intervalt, false, irep_id_hash>
+    int_mapt;
+  typedef sharing_mapt<irep_idt, ieee_float_intervalt, false, irep_id_hash>
+    float_mapt;
 
   int_mapt int_map;
   float_mapt float_map;
@@ -128,4 +139,17 @@ protected:
   ieee_float_intervalt get_float_rec(const exprt &);
 };
 
+/// Domain factory that supports widening of \ref interval_domaint
+class interval_domain_factoryt
+  : public ai_domain_factory_default_constructort<interval_domaint>
+{
+public:
+  bool widen(statet &dest, const statet &src, trace_ptrt, trace_ptrt)
+    const override
+  {
+    return static_cast<interval_domaint &>(dest).widen(
+      static_cast<const interval_domaint &>(src));
+  }
+};
+
 #endif // CPROVER_ANALYSES_INTERVAL_DOMAIN_H
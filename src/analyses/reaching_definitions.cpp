@@ -81,7 +81,7 @@ void rd_range_domaint::populate_cache(const irep_idt &identifier) const
 
   for(const auto &id : v_entry->second)
   {
-    const reaching_definitiont &v=bv_container->get(id);
+    const reaching_definitiont &v=bv_container->get(identifier, id);
 
     export_entry[v.definition_at].insert(
       std::make_pair(v.bit_begin, v.bit_end));
@@ -288,14 +288,14 @@ void rd_range_domaint::transform_end_function(
     {
       for(const auto &id : new_value.second)
       {
-        const reaching_definitiont &v=bv_container->get(id);
+        const reaching_definitiont &v=bv_container->get(identifier, id);
         kill(v.identifier, v.bit_begin, v.bit_end);
       }
     }
 
     for(const auto &id : new_value.second)
     {
-      const reaching_definitiont &v=bv_container->get(id);
+      const reaching_definitiont &v=bv_container->get(identifier, id);
       gen(v.definition_at, v.identifier, v.bit_begin, v.bit_end);
     }
   }
@@ -387,44 +387,35 @@ void rd_range_domaint::kill(
   if(entry==values.end())
     return;
 
-  bool clear_export_cache=false;
+  values_innert killed;
   values_innert new_values;
 
-  for(values_innert::iterator
-      it=entry->second.begin();
-      it!=entry->second.end();
-     ) // no ++it
+  for(const auto &id : entry->second)
   {
-    const reaching_definitiont &v=bv_container->get(*it);
+    const reaching_definitiont &v=bv_container->get(identifier, id);
 
     if(v.bit_begin >= range_end)
-      ++it;
+      continue;
     else if(v.bit_end!=-1 &&
             v.bit_end <= range_start)
-      ++it;
+      continue;
     else if(v.bit_begin >= range_start &&
             v.bit_end!=-1 &&
             v.bit_end <= range_end) // rs <= a < b <= re
     {
-      clear_export_cache=true;
-
-      entry->second.erase(it++);
+      killed.insert(id);
     }
     else if(v.bit_begin >= range_start) // rs <= a <= re < b
     {
-      clear_export_cache=true;
-
       reaching_definitiont v_new=v;
       v_new.bit_begin=range_end;
       new_values.insert(bv_container->add(v_new));
 
-      entry->second.erase(it++);
+      killed.insert(id);
     }
     else if(v.bit_end==-1 ||
             v.bit_end > range_end) // a <= rs < re < b
     {
-      clear_export_cache=true;
-
       reaching_definitiont v_new=v;
       v_new.bit_end=range_start;
 
@@ -434,38 +425,26 @@ void rd_range_domaint::kill(
       new_values.insert(bv_container->add(v_new));
       new_values.insert(bv_container->add(v_new2));
 
-      entry->second.erase(it++);
+      killed.insert(id);
     }
     else // a <= rs < b <= re
     {
-      clear_export_cache=true;
-
       reaching_definitiont v_new=v;
       v_new.bit_end=range_start;
       new_values.insert(bv_container->add(v_new));
 
-      entry->second.erase(it++);
+      killed.insert(id);
     }
   }
 
-  if(clear_export_cache)
-    export_cache.erase(identifier);
+  if(killed.empty())
+    return;
 
-  values_innert::iterator it=entry->second.begin();
-  for(const auto &id : new_values)
-  {
-    while(it!=entry->second.end() && *it<id)
-      ++it;
-    if(it==entry->second.end() || id<*it)
-    {
-      entry->second.insert(it, id);
-    }
-    else if(it!=entry->second.end())
-    {
-      assert(*it==id);
-      ++it;
-    }
-  }
+  export_cache.erase(identifier);
+
+  // kill and gen in one pass over the words of the bit vectors
+  entry->second.subtract(killed);
+  entry->second.union_with(new_values);
 }
 
 void rd_range_domaint::kill_inf(
@@ -527,7 +506,7 @@ bool rd_range_domaint::gen(
   v.bit_begin=range_start;
   v.bit_end=range_end;
 
-  if(!values[identifier].insert(bv_container->add(v)).second)
+  if(!values[identifier].insert(bv_container->add(v)))
     return false;
 
   export_cache.erase(identifier);
@@ -622,50 +601,7 @@ bool rd_range_domaint::merge_inner(
   values_innert &dest,
   const values_innert &other)
 {
-  bool more=false;
-
-#if 0
-  ranges_at_loct::iterator itr=it->second.begin();
-  for(const auto &o : ito->second)
-  {
-    while(itr!=it->second.end() && itr->first<o.first)
-      ++itr;
-    if(itr==it->second.end() || o.first<itr->first)
-    {
-      it->second.insert(o);
-      more=true;
-    }
-    else if(itr!=it->second.end())
-    {
-      assert(itr->first==o.first);
-
-      for(const auto &o_range : o.second)
-        more=gen(itr->second, o_range.first, o_range.second) ||
-          more;
-
-      ++itr;
-    }
-  }
-#else
-  values_innert::iterator itr=dest.begin();
-  for(const auto &id : other)
-  {
-    while(itr!=dest.end() && *itr<id)
-      ++itr;
-    if(itr==dest.end() || id<*itr)
-    {
-      dest.insert(itr, id);
-      more=true;
-    }
-    else if(itr!=dest.end())
-    {
-      assert(*itr==id);
-      ++itr;
-    }
-  }
-#endif
-
-  return more;
+  return dest.union_with(other);
 }
 
 /// \return returns true iff there is something new
@@ -26,6 +26,7 @@ Date: February 2013
 #define CPROVER_ANALYSES_REACHING_DEFINITIONS_H
 
 #include <util/base_exceptions.h>
+#include <util/dense_bitvector.h>
 #include <util/threeval.h>
 
 #include "ai.h"
@@ -37,48 +38,59 @@ class dirtyt;
 class reaching_definitions_analysist;
 
 /// An instance of this class provides an assignment of unique numeric `ID` to
-/// each inserted `reaching_definitiont` instance.
+/// each inserted `reaching_definitiont` instance. The `ID`s are dense per
+/// variable: the values for one variable are numbered 0, 1, 2, ..., which
+/// makes them suitable as indices into a `dense_bitvectort`.
 /// Requirement: V has a member "identifier" of type irep_idt
 template<typename V>
 class sparse_bitvector_analysist
 {
 public:
-  const V &get(const std::size_t value_index) const
+  const V &get(const irep_idt &identifier, const std::size_t value_index) const
   {
-    assert(value_index<values.size());
-    return values[value_index]->first;
+    const auto entry = value_map.find(identifier);
+    PRECONDITION(entry != value_map.end());
+    PRECONDITION(value_index < entry->second.values.size());
+    return entry->second.values[value_index]->first;
   }
 
   std::size_t add(const V &value)
   {
-    inner_mapt &m=value_map[value.identifier];
+    entryt &entry = value_map[value.identifier];
 
-    std::pair<typename inner_mapt::iterator, bool> entry=
-      m.insert(std::make_pair(value, values.size()));
+    std::pair<typename inner_mapt::iterator, bool> inserted =
+      entry.value_to_id.insert(
+        std::make_pair(value, entry.values.size()));
 
-    if(entry.second)
-      values.push_back(entry.first);
+    if(inserted.second)
+      entry.values.push_back(inserted.first);
 
-    return entry.first->second;
+    return inserted.first->second;
   }
 
   void clear()
   {
     value_map.clear();
-    values.clear();
   }
 
 protected:
   typedef typename std::map<V, std::size_t> inner_mapt;
-  /// It is a map from an `ID` to the corresponding `reaching_definitiont`
-  /// instance inside the map `value_map`. Namely, the map is implemented as an
-  /// `std::vector` of iterators to elements of the map `value_map`. An index to
-  /// this vector is the `ID` of the related `reaching_definitiont` instance.
-  std::vector<typename inner_mapt::const_iterator> values;
-  /// A map from names of program variables to a set of pairs
-  /// (`reaching_definitiont`, `ID`). Formally, the map is defined as
-  /// `value_map: var_names -> (reaching_definitiont -> ID)`.
-  std::unordered_map<irep_idt, inner_mapt> value_map;
+
+  struct entryt
+  {
+    /// A map from `reaching_definitiont` instances of one variable to their
+    /// `ID`s.
+    inner_mapt value_to_id;
+    /// A map from an `ID` to the corresponding `reaching_definitiont`
+    /// instance inside `value_to_id`. Namely, the map is implemented as an
+    /// `std::vector` of iterators to elements of `value_to_id`. An index to
+    /// this vector is the `ID` of the related `reaching_definitiont` instance.
+    std::vector<typename inner_mapt::const_iterator> values;
+  };
+
+  /// A map from names of program variables to the numbering of their
+  /// `reaching_definitiont` instances.
+  std::unordered_map<irep_idt, entryt> value_map;
 };
 
 /// Identifies a GOTO instruction where a given variable is defined (i.e. it is
@@ -254,7 +266,8 @@ private:
   /// `this` is passed to `set_bitvector_container` for all instances.
   sparse_bitvector_analysist<reaching_definitiont> *const bv_container;
 
-  typedef std::set<std::size_t> values_innert;
+  /// The `ID`s of the reaching definitions of one variable
+  typedef dense_bitvectort values_innert;
   #ifdef USE_DSTRING
   typedef std::map<irep_idt, values_innert> valuest;
   #else
@@ -262,9 +275,10 @@ private:
   #endif
   /// It is an ordered map from program variable names to `ID`s of
   /// `reaching_definitiont` instances stored in map pointed to by
-  /// `bv_container`. The map is not empty only if `has_value` is `UNKNOWN`.
-  /// Variables in the map are all those which are live at the associated
-  /// instruction.
+  /// `bv_container`. Each set of `ID`s is a bit vector, so joins and kills
+  /// work on whole machine words. The map is not empty only if `has_value` is
+  /// `UNKNOWN`. Variables in the map are all those which are live at the
+  /// associated instruction.
   valuest values;
 
   #ifdef USE_DSTRING
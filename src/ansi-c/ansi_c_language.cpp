@@ -24,6 +24,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "expr2c.h"
 #include "c_preprocess.h"
 #include "ansi_c_internal_additions.h"
+#include "precompiled_internal_additions.h"
 #include "type2name.h"
 
 std::set<std::string> ansi_c_languaget::extensions() const
@@ -64,12 +65,25 @@ bool ansi_c_languaget::parse(
 
   std::istringstream i_preprocessed(o_preprocessed.str());
 
+  return parse_preprocessed(i_preprocessed, path);
+}
+
+bool ansi_c_languaget::parse_preprocessed(
+  std::istream &instream,
+  const std::string &path)
+{
+  // store the path
+  parse_path=path;
+
   // parsing
 
   std::string code;
   ansi_c_internal_additions(code);
   std::istringstream codestr(code);
 
+  internal_additions =
+    get_precompiled_internal_additions(code, get_message_handler());
+
   ansi_c_parser.clear();
   ansi_c_parser.set_file(ID_built_in);
   ansi_c_parser.in=&codestr;
@@ -80,15 +94,25 @@ bool ansi_c_languaget::parse(
   ansi_c_parser.cpp11=false; // it's not C++
   ansi_c_parser.mode=config.ansi_c.mode;
 
-  ansi_c_scanner_init();
+  bool result;
 
-  bool result=ansi_c_parser.parse();
+  if(internal_additions!=nullptr)
+  {
+    // the typedef names declared by the internal additions
+    ansi_c_parser.root_scope()=internal_additions->scope;
+    result=false;
+  }
+  else
+  {
+    ansi_c_scanner_init();
+    result=ansi_c_parser.parse();
+  }
 
   if(!result)
   {
     ansi_c_parser.set_line_no(0);
     ansi_c_parser.set_file(path);
-    ansi_c_parser.in=&i_preprocessed;
+    ansi_c_parser.in=&instream;
     ansi_c_scanner_init();
     result=ansi_c_parser.parse();
   }
@@ -109,6 +133,17 @@ bool ansi_c_languaget::typecheck(
 {
   symbol_tablet new_symbol_table;
 
+  // the internal additions were not parsed along with the file
+  if(internal_additions!=nullptr)
+  {
+    for(const auto &symbol_pair : internal_additions->symbol_table.symbols)
+    {
+      symbolt symbol=symbol_pair.second;
+      symbol.module=module;
+      new_symbol_table.add(symbol);
+    }
+  }
+
   if(ansi_c_typecheck(
     parse_tree,
     new_symbol_table,
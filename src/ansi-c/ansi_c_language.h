@@ -31,6 +31,8 @@ Author: Daniel Kroening, kroening@kroening.com
   "                              NULL in a recursively nondet initialized struct\n" /* NOLINT(*) */
 // clang-format on
 
+struct precompiled_internal_additionst;
+
 class ansi_c_languaget:public languaget
 {
 public:
@@ -48,6 +50,9 @@ public:
     std::istream &instream,
     const std::string &path) override;
 
+  bool parse_preprocessed(std::istream &instream, const std::string &path)
+    override;
+
   bool generate_support_functions(
     symbol_tablet &symbol_table) override;
 
@@ -106,6 +111,10 @@ protected:
   ansi_c_parse_treet parse_tree;
   std::string parse_path;
 
+  /// The internal additions in precompiled form, if they were not parsed
+  /// along with the file
+  const precompiled_internal_additionst *internal_additions = nullptr;
+
   c_object_factory_parameterst object_factory_params;
 };
 
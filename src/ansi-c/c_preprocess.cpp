@@ -10,13 +10,32 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/c_types.h>
 #include <util/config.h>
+#include <util/file_util.h>
 #include <util/prefix.h>
 #include <util/run.h>
+#include <util/string2int.h>
+#include <util/string_hash.h>
 #include <util/suffix.h>
 #include <util/tempfile.h>
 #include <util/unicode.h>
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <ctime>
 #include <fstream>
+#include <set>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <sys/stat.h>
+#include <utime.h>
+#endif
+
+#include "precompiled_cache.h"
 
 /// quote a string for bash and CMD
 static std::string shell_quote(const std::string &src)
@@ -223,6 +242,12 @@ static void error_parse(
     error_parse_line(line, warning_only, message);
 }
 
+static bool c_preprocess(
+  const std::string &path,
+  std::ostream &outstream,
+  message_handlert &message_handler,
+  bool use_cache);
+
 /// ANSI-C preprocessing
 bool c_preprocess(
   std::istream &instream,
@@ -244,7 +269,10 @@ bool c_preprocess(
 
   tmp.close(); // flush
 
-  bool result=c_preprocess(tmp_file(), outstream, message_handler);
+  // the name of the temporary file changes from run to run, hence caching
+  // its output would only fill the cache
+  bool result =
+    c_preprocess(tmp_file(), outstream, message_handler, false);
 
   return result;
 }
@@ -259,12 +287,13 @@ static bool is_dot_i_file(const std::string &path)
 bool c_preprocess_codewarrior(
   const std::string &, std::ostream &, message_handlert &);
 bool c_preprocess_arm(
-  const std::string &, std::ostream &, message_handlert &);
+  const std::string &, std::ostream &, message_handlert &, bool use_cache);
 bool c_preprocess_gcc_clang(
   const std::string &,
   std::ostream &,
   message_handlert &,
-  configt::ansi_ct::preprocessort);
+  configt::ansi_ct::preprocessort,
+  bool use_cache);
 bool c_preprocess_none(
   const std::string &, std::ostream &, message_handlert &);
 bool c_preprocess_visual_studio(
@@ -274,6 +303,17 @@ bool c_preprocess(
   const std::string &path,
   std::ostream &outstream,
   message_handlert &message_handler)
+{
+  return c_preprocess(path, outstream, message_handler, true);
+}
+
+/// \param use_cache: whether the output may be taken from and stored in the
+///   directory given in CPROVER_PREPROCESSOR_CACHE
+static bool c_preprocess(
+  const std::string &path,
+  std::ostream &outstream,
+  message_handlert &message_handler,
+  bool use_cache)
 {
   switch(config.ansi_c.preprocessor)
   {
@@ -283,18 +323,26 @@ bool c_preprocess(
   case configt::ansi_ct::preprocessort::GCC:
     return
       c_preprocess_gcc_clang(
-        path, outstream, message_handler, config.ansi_c.preprocessor);
+        path,
+        outstream,
+        message_handler,
+        config.ansi_c.preprocessor,
+        use_cache);
 
   case configt::ansi_ct::preprocessort::CLANG:
     return
       c_preprocess_gcc_clang(
-        path, outstream, message_handler, config.ansi_c.preprocessor);
+        path,
+        outstream,
+        message_handler,
+        config.ansi_c.preprocessor,
+        use_cache);
 
   case configt::ansi_ct::preprocessort::VISUAL_STUDIO:
     return c_preprocess_visual_studio(path, outstream, message_handler);
 
   case configt::ansi_ct::preprocessort::ARM:
-    return c_preprocess_arm(path, outstream, message_handler);
+    return c_preprocess_arm(path, outstream, message_handler, use_cache);
 
   case configt::ansi_ct::preprocessort::NONE:
     return c_preprocess_none(path, outstream, message_handler);
@@ -505,12 +553,262 @@ bool c_preprocess_codewarrior(
   return false;
 }
 
+/// \return the path of the file that caches the output of the preprocessor
+///   command \p key in \p directory
+static std::string
+preprocessor_cache_file(const std::string &directory, const std::string &key)
+{
+  return concat_dir_file(
+    directory, "preprocessed_" + string_digest(key) + ".i");
+}
+
+/// Remove the least recently used entries of the preprocessor cache in
+/// \p directory once they take up more than CPROVER_PREPROCESSOR_CACHE_SIZE
+/// mebibytes (default 1024), until they take up at most 90% of it
+static void
+evict_preprocessor_cache(const std::string &directory, messaget &message)
+{
+#ifndef _WIN32
+  std::size_t max_size = std::size_t(1024) << 20;
+
+  const char *size = getenv("CPROVER_PREPROCESSOR_CACHE_SIZE");
+  if(size != nullptr)
+  {
+    const auto mebibytes = string2optional_size_t(size);
+    if(mebibytes.has_value())
+      max_size = *mebibytes << 20;
+    else
+    {
+      message.warning() << "ignoring invalid CPROVER_PREPROCESSOR_CACHE_SIZE '"
+                        << size << "'" << messaget::eom;
+    }
+  }
+
+  DIR *dir = opendir(directory.c_str());
+  if(dir == nullptr)
+    return;
+
+  std::vector<std::pair<time_t, std::string>> entries;
+  std::size_t total_size = 0;
+
+  while(const dirent *entry = readdir(dir))
+  {
+    const std::string name = entry->d_name;
+    if(!has_prefix(name, "preprocessed_") || !has_suffix(name, ".i"))
+      continue;
+
+    const std::string path = concat_dir_file(directory, name);
+    struct stat info;
+    if(stat(path.c_str(), &info) != 0)
+      continue;
+
+    entries.emplace_back(info.st_mtime, path);
+    total_size += static_cast<std::size_t>(info.st_size);
+  }
+
+  closedir(dir);
+
+  if(total_size <= max_size)
+    return;
+
+  std::sort(entries.begin(), entries.end());
+
+  for(const auto &entry : entries)
+  {
+    if(total_size <= max_size / 10 * 9)
+      break;
+
+    struct stat info;
+    if(stat(entry.second.c_str(), &info) == 0 && file_remove(entry.second))
+    {
+      const auto size = static_cast<std::size_t>(info.st_size);
+      total_size -= std::min(total_size, size);
+    }
+  }
+#else
+  (void)directory;
+  (void)message;
+#endif
+}
+
+/// Store a digest of the contents of the file \p path in \p digest
+/// \return true on error
+static bool digest_file(const std::string &path, std::string &digest)
+{
+  std::ifstream in(path, std::ios::binary);
+  if(!in)
+    return true;
+
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  digest = string_digest(contents.str());
+  return false;
+}
+
+/// \return the files named in the line markers of the \p preprocessed
+///   source, i.e., the source file and all files it includes
+static std::set<std::string> included_files(const std::string &preprocessed)
+{
+  std::set<std::string> result;
+
+  for(std::size_t pos = 0; pos < preprocessed.size();)
+  {
+    std::size_t end = preprocessed.find('\n', pos);
+    if(end == std::string::npos)
+      end = preprocessed.size();
+
+    // # 1 "file.h" 1, or #line 1 "file.h"
+    std::size_t open = end;
+    if(preprocessed[pos] == '#')
+    {
+      std::size_t i = preprocessed.find_first_not_of(" \t", pos + 1);
+      if(i < end && preprocessed.compare(i, 4, "line") == 0)
+        i = preprocessed.find_first_not_of(" \t", i + 4);
+      if(i < end && isdigit(preprocessed[i]))
+        open = preprocessed.find('"', i);
+    }
+
+    if(open < end)
+    {
+      std::string file;
+      std::size_t i = open + 1;
+      for(; i < end && preprocessed[i] != '"'; ++i)
+      {
+        if(preprocessed[i] == '\\' && i + 1 < end)
+          ++i;
+        file += preprocessed[i];
+      }
+
+      // <built-in>, <command-line> and the like are not files
+      if(i < end && !file.empty() && file[0] != '<')
+        result.insert(file);
+    }
+
+    pos = end + 1;
+  }
+
+  return result;
+}
+
+/// Copy the cached output of the preprocessor command \p key from \p path to
+/// \p outstream, unless one of the files it was computed from has changed
+/// \return true if there is no valid cached output
+static bool read_preprocessor_cache(
+  const std::string &path,
+  const std::string &key,
+  std::ostream &outstream)
+{
+  return read_precompiled_cache_file(path, key, [&](std::istream &in) {
+    std::size_t number_of_files;
+    if(!(in >> number_of_files) || in.get() != '\n')
+      return true;
+
+    for(std::size_t i = 0; i < number_of_files; ++i)
+    {
+      std::string digest, cached_digest;
+      std::size_t size;
+      if(!(in >> cached_digest >> size) || in.get() != ' ')
+        return true;
+
+      std::string file(size, 0);
+      if(
+        !in.read(&file[0], size) || in.get() != '\n' ||
+        digest_file(file, digest) || digest != cached_digest)
+      {
+        return true;
+      }
+    }
+
+    outstream << in.rdbuf();
+    return false;
+  });
+}
+
+/// Run the preprocessor command \p argv, with its output going to
+/// \p outstream and its diagnostics to \p stderr_file. If \p use_cache is
+/// set and the environment variable CPROVER_PREPROCESSOR_CACHE names a
+/// directory, the output is stored there, along with digests of the source
+/// file and all files it includes, and reused as long as the command and
+/// these files are unchanged. Reused output comes without the diagnostics of
+/// the original run. Changes that do not touch any file that was included,
+/// such as a new header that shadows one in a later include directory, are
+/// not detected. The least recently used entries are removed once the cache
+/// exceeds CPROVER_PREPROCESSOR_CACHE_SIZE mebibytes.
+/// \return the exit code of the preprocessor
+static int run_preprocessor(
+  const std::vector<std::string> &argv,
+  std::ostream &outstream,
+  const std::string &stderr_file,
+  bool use_cache,
+  messaget &message)
+{
+  const char *directory = getenv("CPROVER_PREPROCESSOR_CACHE");
+  if(!use_cache || directory == nullptr || *directory == 0)
+    return run(argv[0], argv, "", outstream, stderr_file);
+
+  // relative paths in the line markers depend on the working directory
+  std::string key = get_current_working_directory();
+  for(const char *variable : {"CPATH", "C_INCLUDE_PATH", "CPLUS_INCLUDE_PATH"})
+  {
+    const char *value = getenv(variable);
+    key += '\0' + std::string(value == nullptr ? "" : value);
+  }
+  for(const auto &arg : argv)
+    key += '\0' + arg;
+
+  const std::string cache_file = preprocessor_cache_file(directory, key);
+
+  if(!read_preprocessor_cache(cache_file, key, outstream))
+  {
+#ifndef _WIN32
+    // mark as recently used
+    utime(cache_file.c_str(), nullptr);
+#endif
+    message.debug() << "Preprocessed output of '" << argv.back()
+                    << "' taken from " << cache_file << messaget::eom;
+    return 0;
+  }
+
+  std::ostringstream preprocessed;
+  const int result = run(argv[0], argv, "", preprocessed, stderr_file);
+  const std::string output = preprocessed.str();
+  outstream << output;
+
+  if(result != 0)
+    return result;
+
+  std::vector<std::pair<std::string, std::string>> files;
+  for(const auto &file : included_files(output))
+  {
+    std::string digest;
+    if(digest_file(file, digest))
+      return result; // cannot tell when this would be out of date
+    files.emplace_back(file, digest);
+  }
+
+  // failing to write the cache is not an error
+  if(!write_precompiled_cache_file(cache_file, key, [&](std::ostream &out) {
+       out << files.size() << '\n';
+       for(const auto &file : files)
+         out << file.second << ' ' << file.first.size() << ' ' << file.first
+             << '\n';
+       out << output;
+       return false;
+     }))
+  {
+    evict_preprocessor_cache(directory, message);
+  }
+
+  return result;
+}
+
 /// ANSI-C preprocessing
 bool c_preprocess_gcc_clang(
   const std::string &file,
   std::ostream &outstream,
   message_handlert &message_handler,
-  configt::ansi_ct::preprocessort preprocessor)
+  configt::ansi_ct::preprocessort preprocessor,
+  bool use_cache)
 {
   // check extension
   if(is_dot_i_file(file))
@@ -694,7 +992,8 @@ bool c_preprocess_gcc_clang(
   argv.push_back(file);
 
   // execute clang or gcc
-  result = run(argv[0], argv, "", outstream, stderr_file());
+  result =
+    run_preprocessor(argv, outstream, stderr_file(), use_cache, message);
 
   // errors/warnings
   std::ifstream stderr_stream(stderr_file());
@@ -713,7 +1012,8 @@ bool c_preprocess_gcc_clang(
 bool c_preprocess_arm(
   const std::string &file,
   std::ostream &outstream,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  bool use_cache)
 {
   // check extension
   if(is_dot_i_file(file))
@@ -765,7 +1065,8 @@ bool c_preprocess_arm(
   int result;
 
   // execute armcc
-  result = run(argv[0], argv, "", outstream, stderr_file());
+  result =
+    run_preprocessor(argv, outstream, stderr_file(), use_cache, message);
 
   // errors/warnings
   std::ifstream stderr_stream(stderr_file());
@@ -15,11 +15,19 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/message.h>
 
+/// Preprocess the file \p path with the preprocessor given in the
+/// configuration, writing the result to \p outstream. The output of GCC,
+/// Clang and the ARM preprocessor is cached in the directory given in the
+/// environment variable CPROVER_PREPROCESSOR_CACHE, if set, which holds up
+/// to CPROVER_PREPROCESSOR_CACHE_SIZE mebibytes (default 1024).
+/// \return true on error
 bool c_preprocess(
   const std::string &path,
   std::ostream &outstream,
   message_handlert &message_handler);
 
+/// Preprocess \p instream as the file variant does, but
+/// without caching the output
 bool c_preprocess(
   std::istream &instream,
   std::ostream &outstream,
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/c_types.h>
 #include <util/cprover_prefix.h>
 #include <util/expr_initializer.h>
+#include <util/magic.h>
 #include <util/prefix.h>
 #include <util/simplify_expr.h>
 #include <util/std_types.h>
@@ -22,6 +23,101 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "anonymous_member.h"
 
+/// Initializers of arrays with more than MAX_FLATTENED_ARRAY_SIZE elements
+/// are not expanded into an array expression. They are an array_of
+/// expression with the default value, which zero_initializer builds for such
+/// arrays, updated by a `with` expression that lists the initialized elements
+/// in increasing order of their index.
+/// \return whether \p expr is such a compact array initializer
+static bool is_compact_array_initializer(const exprt &expr)
+{
+  return expr.id() == ID_array_of || expr.id() == ID_with;
+}
+
+/// \return the element with index \p index of the compact array initializer
+///   \p array, adding it with the default value if it is not there yet
+static exprt &compact_array_element(exprt &array, std::size_t index)
+{
+  const exprt where = from_integer(index, index_type());
+
+  if(array.id() == ID_array_of)
+  {
+    const exprt default_value = to_array_of_expr(array).what();
+    with_exprt with_expr(array, where, default_value);
+    with_expr.add_source_location() = array.source_location();
+    array = std::move(with_expr);
+    return to_with_expr(array).new_value();
+  }
+
+  exprt::operandst &operands = to_with_expr(array).operands();
+
+  const auto index_of = [&operands](std::size_t pair) {
+    return numeric_cast_v<std::size_t>(to_constant_expr(operands[pair]));
+  };
+
+  // initializers mostly go through the elements in order
+  std::size_t pair = operands.size();
+  if(index <= index_of(operands.size() - 2))
+  {
+    // binary search on the indices, at the odd positions
+    std::size_t lower = 0, upper = operands.size() / 2;
+    while(lower < upper)
+    {
+      const std::size_t middle = (lower + upper) / 2;
+      if(index_of(2 * middle + 1) < index)
+        lower = middle + 1;
+      else
+        upper = middle;
+    }
+
+    pair = 2 * lower + 1;
+    if(index_of(pair) == index)
+      return operands[pair + 1];
+  }
+
+  const exprt default_value = to_array_of_expr(operands.front()).what();
+  const auto it = operands.insert(
+    std::next(operands.begin(), pair), {where, default_value});
+  return *std::next(it);
+}
+
+/// Fill up the array initializer \p array of type \p type, which has fewer
+/// than \p array_size elements, with \p zero
+static void pad_array_initializer(
+  exprt &array,
+  const array_typet &type,
+  const mp_integer &array_size,
+  const exprt &zero)
+{
+  if(array_size <= MAX_FLATTENED_ARRAY_SIZE)
+  {
+    array.operands().resize(numeric_cast_v<std::size_t>(array_size), zero);
+    return;
+  }
+
+  array_of_exprt array_of(zero, type);
+  array_of.add_source_location() = array.source_location();
+
+  if(array.operands().empty())
+  {
+    array = std::move(array_of);
+    return;
+  }
+
+  exprt::operandst operands;
+  operands.reserve(1 + 2 * array.operands().size());
+  operands.push_back(std::move(array_of));
+  for(std::size_t i = 0; i < array.operands().size(); ++i)
+  {
+    operands.push_back(from_integer(i, index_type()));
+    operands.push_back(std::move(array.operands()[i]));
+  }
+
+  exprt with_expr(ID_with, type, std::move(operands));
+  with_expr.add_source_location() = array.source_location();
+  array = std::move(with_expr);
+}
+
 void c_typecheck_baset::do_initializer(
   exprt &initializer,
   const typet &type,
@@ -37,7 +133,7 @@ void c_typecheck_baset::do_initializer(
                    "any array must have a size");
 
     // we don't allow initialisation with symbols of array type
-    if(result.id() != ID_array && result.id() != ID_array_of)
+    if(result.id() != ID_array && !is_compact_array_initializer(result))
     {
       error().source_location = result.source_location();
       error() << "invalid array initializer " << to_string(result)
@@ -126,7 +222,8 @@ exprt c_typecheck_baset::do_initializer_rec(
                   << to_string(full_type.subtype()) << "'" << eom;
           throw 0;
         }
-        tmp.operands().resize(numeric_cast_v<std::size_t>(*array_size), *zero);
+        pad_array_initializer(
+          tmp, to_array_type(full_type), *array_size, *zero);
       }
     }
 
@@ -188,7 +285,8 @@ exprt c_typecheck_baset::do_initializer_rec(
                   << to_string(full_type.subtype()) << "'" << eom;
           throw 0;
         }
-        tmp2.operands().resize(numeric_cast_v<std::size_t>(*array_size), *zero);
+        pad_array_initializer(
+          tmp2, to_array_type(full_type), *array_size, *zero);
       }
     }
 
@@ -394,8 +492,21 @@ exprt::operandst::const_iterator c_typecheck_baset::do_designated_initializer(
     const typet &type=designator[i].type;
     const typet &full_type=follow(type);
 
-    if(full_type.id()==ID_array ||
-       full_type.id()==ID_vector)
+    if(full_type.id() == ID_array && is_compact_array_initializer(*dest))
+    {
+      const auto array_size =
+        numeric_cast<mp_integer>(to_array_type(full_type).size());
+      if(!array_size.has_value() || index >= *array_size)
+      {
+        error().source_location = value.source_location();
+        error() << "array index designator " << index << " out of bounds ("
+                << to_string(to_array_type(full_type).size()) << ")" << eom;
+        throw 0;
+      }
+
+      dest = &compact_array_element(*dest, index);
+    }
+    else if(full_type.id() == ID_array || full_type.id() == ID_vector)
     {
       if(index>=dest->operands().size())
       {
@@ -634,7 +745,10 @@ exprt::operandst::const_iterator c_typecheck_baset::do_designated_initializer(
       }
     }
 
-    dest = &(to_multi_ary_expr(*dest).op0());
+    if(is_compact_array_initializer(*dest))
+      dest = &compact_array_element(*dest, 0);
+    else
+      dest = &(to_multi_ary_expr(*dest).op0());
 
     // we run into another loop iteration
   }
@@ -8,15 +8,34 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "cprover_library.h"
 
+#include <map>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 #include <util/config.h>
+#include <util/file_util.h>
+#include <util/find_symbols.h>
+#include <util/version.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include <linking/linking.h>
 
 #include "ansi_c_language.h"
+#include "precompiled_cache.h"
 
-static std::string get_cprover_library_text(
-  const std::set<irep_idt> &functions,
-  const symbol_tablet &symbol_table)
+// cprover_library.inc may not have been generated when running Doxygen, thus
+// make Doxygen skip this part
+/// \cond
+static const struct cprover_library_entryt cprover_library[] =
+#include "cprover_library.inc"
+  ; // NOLINT(whitespace/semicolon)
+/// \endcond
+
+static std::string get_cprover_library_prologue()
 {
   std::ostringstream library_text;
 
@@ -27,16 +46,15 @@ static std::string get_cprover_library_text(
   if(config.ansi_c.string_abstraction)
     library_text << "#define " CPROVER_PREFIX "STRING_ABSTRACTION\n";
 
-  // cprover_library.inc may not have been generated when running Doxygen, thus
-  // make Doxygen skip this part
-  /// \cond
-  const struct cprover_library_entryt cprover_library[] =
-#include "cprover_library.inc"
-    ; // NOLINT(whitespace/semicolon)
-  /// \endcond
+  return library_text.str();
+}
 
+static std::string get_cprover_library_text(
+  const std::set<irep_idt> &functions,
+  const symbol_tablet &symbol_table)
+{
   return get_cprover_library_text(
-    functions, symbol_table, cprover_library, library_text.str());
+    functions, symbol_table, cprover_library, get_cprover_library_prologue());
 }
 
 std::string get_cprover_library_text(
@@ -74,6 +92,196 @@ std::string get_cprover_library_text(
     return library_text.str();
 }
 
+/// Everything in the configuration that preprocessing or type checking the
+/// library may depend on
+static std::string get_cprover_library_configuration()
+{
+  const configt::ansi_ct &ansi_c = config.ansi_c;
+
+  std::ostringstream configuration;
+  configuration << CBMC_VERSION << '\n'
+                << ansi_c.arch << ' '
+                << configt::ansi_ct::os_to_string(ansi_c.os) << ' '
+                << static_cast<int>(ansi_c.endianness) << ' '
+                << static_cast<int>(ansi_c.mode) << ' '
+                << static_cast<int>(ansi_c.preprocessor) << ' '
+                << static_cast<int>(ansi_c.c_standard) << '\n'
+                << ansi_c.int_width << ' ' << ansi_c.long_int_width << ' '
+                << ansi_c.bool_width << ' ' << ansi_c.char_width << ' '
+                << ansi_c.short_int_width << ' '
+                << ansi_c.long_long_int_width << ' ' << ansi_c.pointer_width
+                << ' ' << ansi_c.single_width << ' ' << ansi_c.double_width
+                << ' ' << ansi_c.long_double_width << ' '
+                << ansi_c.wchar_t_width << '\n'
+                << ansi_c.char_is_unsigned << ansi_c.wchar_t_is_unsigned
+                << ansi_c.for_has_scope << ansi_c.ts_18661_3_Floatn_types
+                << ansi_c.gcc__float128_type
+                << ansi_c.single_precision_constant << ansi_c.NULL_is_zero
+                << ansi_c.string_abstraction << ' '
+                << static_cast<int>(ansi_c.rounding_mode) << ' '
+                << ansi_c.alignment << ' ' << ansi_c.memory_operand_size << ' '
+                << config.bv_encoding.object_bits << '\n';
+
+  for(const auto &list : {ansi_c.defines,
+                          ansi_c.undefines,
+                          ansi_c.preprocessor_options,
+                          ansi_c.include_paths,
+                          ansi_c.include_files})
+  {
+    for(const auto &entry : list)
+      configuration << entry << '\n';
+    configuration << '\n';
+  }
+
+  return configuration.str();
+}
+
+/// Parse and type check \p src into \p symbol_table
+/// \return true on error
+static bool add_library_text(
+  const std::string &src,
+  symbol_tablet &symbol_table,
+  message_handlert &message_handler)
+{
+  std::istringstream in(src);
+
+  ansi_c_languaget ansi_c_language;
+  ansi_c_language.set_message_handler(message_handler);
+  if(ansi_c_language.parse(in, ""))
+    return true;
+
+  return ansi_c_language.typecheck(symbol_table, "<built-in-library>");
+}
+
+/// Type check the models of all library functions for the current
+/// configuration. Each model is type checked on its own, as it would be when
+/// requested by itself, and models that fail to type check (for instance as
+/// they are not available on this platform) are left out.
+static void build_precompiled_cprover_library(symbol_tablet &dest)
+{
+  const std::string prologue = get_cprover_library_prologue();
+  null_message_handlert null_message_handler;
+
+  for(const cprover_library_entryt *e = cprover_library; e->function != nullptr;
+      e++)
+  {
+    symbol_tablet attempt = dest;
+    if(!add_library_text(
+         prologue + e->model + '\n', attempt, null_message_handler))
+    {
+      dest.swap(attempt);
+    }
+  }
+}
+
+/// The precompiled library for the current configuration, if the directory
+/// given in the environment variable CPROVER_LIBRARY_CACHE holds one. If the
+/// directory holds none yet, the library is built and stored there for later
+/// runs. The library is loaded at most once per process.
+/// \return nullptr if CPROVER_LIBRARY_CACHE is not set
+static const symbol_tablet *
+get_precompiled_cprover_library(message_handlert &message_handler)
+{
+  const std::string configuration = get_cprover_library_configuration();
+  const std::string path =
+    precompiled_cache_file("cprover_library", configuration);
+  if(path.empty())
+    return nullptr;
+
+  static std::map<std::string, std::unique_ptr<symbol_tablet>> libraries;
+
+  std::unique_ptr<symbol_tablet> &library = libraries[configuration];
+  if(library)
+    return library.get();
+
+  messaget log(message_handler);
+
+  if(file_exists(path))
+  {
+    library = std::unique_ptr<symbol_tablet>(new symbol_tablet());
+    symbol_tablet &symbol_table = *library;
+    if(!read_precompiled_cache_file(
+         path, configuration, [&path, &symbol_table](std::istream &in) {
+           null_message_handlert null_message_handler;
+           goto_functionst goto_functions;
+           return read_bin_goto_object(
+             in, path, symbol_table, goto_functions, null_message_handler);
+         }))
+    {
+      log.debug() << "Using precompiled library " << path << messaget::eom;
+      return library.get();
+    }
+
+    log.warning() << "failed to read precompiled library '" << path
+                  << "', rebuilding it" << messaget::eom;
+  }
+
+  log.status() << "Building precompiled library " << path << messaget::eom;
+
+  library = std::unique_ptr<symbol_tablet>(new symbol_tablet());
+  build_precompiled_cprover_library(*library);
+
+  const symbol_tablet &symbol_table = *library;
+  if(write_precompiled_cache_file(
+       path, configuration, [&symbol_table](std::ostream &out) {
+         return write_goto_binary(out, symbol_table, goto_functionst());
+       }))
+  {
+    log.warning() << "failed to write precompiled library '" << path << "'"
+                  << messaget::eom;
+  }
+
+  return library.get();
+}
+
+/// Merge the definitions of \p functions from \p library into
+/// \p symbol_table, together with the symbols they depend on. Other library
+/// functions are added without their body, which the linker requests once
+/// they are called. As when type checking the text of the library, the
+/// symbols are merged by the linker, which reports conflicts with the
+/// declarations in \p symbol_table.
+static void add_precompiled_library(
+  const std::set<irep_idt> &functions,
+  const symbol_tablet &library,
+  symbol_tablet &symbol_table,
+  message_handlert &message_handler)
+{
+  symbol_tablet new_symbol_table;
+  std::vector<irep_idt> todo(functions.begin(), functions.end());
+
+  while(!todo.empty())
+  {
+    const irep_idt id = todo.back();
+    todo.pop_back();
+
+    if(new_symbol_table.has_symbol(id))
+      continue;
+
+    const symbolt *library_symbol = library.lookup(id);
+    if(library_symbol == nullptr)
+      continue;
+
+    symbolt symbol = *library_symbol;
+    if(symbol.type.id() == ID_code && functions.count(id) == 0)
+      symbol.value.make_nil();
+
+    find_symbols_sett dependencies;
+    find_type_and_expr_symbols(symbol.type, dependencies);
+    find_type_and_expr_symbols(symbol.value, dependencies);
+
+    if(symbol.type.id() == ID_code && symbol.value.is_not_nil())
+    {
+      for(const auto &parameter : to_code_type(symbol.type).parameters())
+        dependencies.insert(parameter.get_identifier());
+    }
+
+    new_symbol_table.add(symbol);
+    todo.insert(todo.end(), dependencies.begin(), dependencies.end());
+  }
+
+  linking(symbol_table, new_symbol_table, message_handler);
+}
+
 void cprover_c_library_factory(
   const std::set<irep_idt> &functions,
   symbol_tablet &symbol_table,
@@ -82,9 +290,38 @@ void cprover_c_library_factory(
   if(config.ansi_c.lib==configt::ansi_ct::libt::LIB_NONE)
     return;
 
+  std::set<irep_idt> remaining_functions = functions;
+
+  const symbol_tablet *library =
+    get_precompiled_cprover_library(message_handler);
+
+  if(library != nullptr)
+  {
+    std::set<irep_idt> precompiled_functions;
+
+    for(const auto &id : functions)
+    {
+      const symbolt *symbol = symbol_table.lookup(id);
+      const symbolt *library_symbol = library->lookup(id);
+
+      if(
+        symbol != nullptr && symbol->value.is_nil() &&
+        library_symbol != nullptr && library_symbol->type.id() == ID_code &&
+        library_symbol->value.is_not_nil())
+      {
+        precompiled_functions.insert(id);
+        remaining_functions.erase(id);
+      }
+    }
+
+    add_precompiled_library(
+      precompiled_functions, *library, symbol_table, message_handler);
+  }
+
+  // functions whose model could not be precompiled
   std::string library_text;
 
-  library_text=get_cprover_library_text(functions, symbol_table);
+  library_text=get_cprover_library_text(remaining_functions, symbol_table);
 
   add_library(library_text, symbol_table, message_handler);
 }
@@ -97,11 +334,5 @@ void add_library(
   if(src.empty())
     return;
 
-  std::istringstream in(src);
-
-  ansi_c_languaget ansi_c_language;
-  ansi_c_language.set_message_handler(message_handler);
-  ansi_c_language.parse(in, "");
-
-  ansi_c_language.typecheck(symbol_table, "<built-in-library>");
+  add_library_text(src, symbol_table, message_handler);
 }
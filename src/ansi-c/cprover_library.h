@@ -32,6 +32,12 @@ void add_library(
   symbol_tablet &,
   message_handlert &);
 
+/// Add the models of those \p functions that are declared, but not defined,
+/// in the symbol table. If the environment variable CPROVER_LIBRARY_CACHE
+/// names a directory, the models are copied from a library that has been
+/// type checked before for the same configuration and stored in that
+/// directory (building it first if there is none), rather than parsed from
+/// their C source.
 void cprover_c_library_factory(
   const std::set<irep_idt> &functions,
   symbol_tablet &,
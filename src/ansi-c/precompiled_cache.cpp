@@ -0,0 +1,83 @@
+/*******************************************************************\
+
+Module: Cache of Precompiled Internal Code
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Files in the directory given by CPROVER_LIBRARY_CACHE that hold
+/// type-checked internal code, such as the CPROVER library
+
+#include "precompiled_cache.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include <util/file_util.h>
+#include <util/string_hash.h>
+
+std::string
+precompiled_cache_file(const std::string &prefix, const std::string &key)
+{
+  const char *directory = getenv("CPROVER_LIBRARY_CACHE");
+  if(directory == nullptr || *directory == 0)
+    return std::string();
+
+  return concat_dir_file(directory, prefix + '_' + string_digest(key) + ".gb");
+}
+
+bool write_precompiled_cache_file(
+  const std::string &path,
+  const std::string &key,
+  const std::function<bool(std::ostream &)> &write)
+{
+  const std::string temporary_path =
+    path + "." + std::to_string(getpid()) + ".tmp";
+  bool failed = true;
+  {
+    std::ofstream out(temporary_path, std::ios::binary);
+    if(out)
+    {
+      out << key.size() << '\n' << key << '\n';
+      failed = write(out) || !out;
+    }
+  }
+
+  if(failed || std::rename(temporary_path.c_str(), path.c_str()) != 0)
+  {
+    file_remove(temporary_path);
+    return true;
+  }
+
+  return false;
+}
+
+bool read_precompiled_cache_file(
+  const std::string &path,
+  const std::string &key,
+  const std::function<bool(std::istream &)> &read)
+{
+  std::ifstream in(path, std::ios::binary);
+  if(!in)
+    return true;
+
+  std::size_t size;
+  if(!(in >> size) || in.get() != '\n' || size != key.size())
+    return true;
+
+  std::string cached_key(size, 0);
+  if(!in.read(&cached_key[0], size) || in.get() != '\n' || cached_key != key)
+    return true;
+
+  return read(in);
+}
@@ -0,0 +1,47 @@
+/*******************************************************************\
+
+Module: Cache of Precompiled Internal Code
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Files in the directory given by CPROVER_LIBRARY_CACHE that hold
+/// type-checked internal code, such as the CPROVER library
+
+#ifndef CPROVER_ANSI_C_PRECOMPILED_CACHE_H
+#define CPROVER_ANSI_C_PRECOMPILED_CACHE_H
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+/// \return the path of the cache file for contents identified by \p key, in
+///   the directory given in the environment variable CPROVER_LIBRARY_CACHE;
+///   the file name starts with \p prefix and ends in a digest of \p key. The
+///   empty string if CPROVER_LIBRARY_CACHE is not set.
+std::string
+precompiled_cache_file(const std::string &prefix, const std::string &key);
+
+/// Write the cache file \p path for contents identified by \p key: the key
+/// itself, followed by the contents written by \p write, which returns true
+/// on error. The file is written under a name of its own first and then
+/// renamed, as other processes may be reading or building the same file at
+/// the same time.
+/// \return true on error
+bool write_precompiled_cache_file(
+  const std::string &path,
+  const std::string &key,
+  const std::function<bool(std::ostream &)> &write);
+
+/// Read the contents of the cache file \p path using \p read, which returns
+/// true on error, provided the file was written for \p key. The name of the
+/// file only holds a digest of the key, which does not rule out collisions.
+/// \return true on error, including a file written for a different key
+bool read_precompiled_cache_file(
+  const std::string &path,
+  const std::string &key,
+  const std::function<bool(std::istream &)> &read);
+
+#endif // CPROVER_ANSI_C_PRECOMPILED_CACHE_H
@@ -0,0 +1,227 @@
+/*******************************************************************\
+
+Module: Precompiled Internal Additions
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// The internal additions that precede each C file, parsed and type-checked
+/// once per configuration
+
+#include "precompiled_internal_additions.h"
+
+#include <map>
+#include <memory>
+#include <sstream>
+
+#include <util/config.h>
+#include <util/exception_utils.h>
+#include <util/file_util.h>
+#include <util/irep_serialization.h>
+#include <util/version.h>
+
+#include <goto-programs/goto_functions.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include "ansi_c_parser.h"
+#include "ansi_c_typecheck.h"
+#include "precompiled_cache.h"
+
+/// Everything besides the text of the internal additions that the result of
+/// parsing and type checking them depends on
+static std::string get_configuration(const std::string &code)
+{
+  std::ostringstream configuration;
+  configuration << CBMC_VERSION << '\n'
+                << static_cast<int>(config.ansi_c.mode) << ' '
+                << static_cast<int>(config.ansi_c.c_standard) << ' '
+                << config.ansi_c.for_has_scope << ' '
+                << config.ansi_c.ts_18661_3_Floatn_types << ' '
+                << config.ansi_c.single_precision_constant << '\n'
+                << code;
+  return configuration.str();
+}
+
+static irept scope_to_irep(const ansi_c_scopet &scope)
+{
+  irept result;
+  result.set("prefix", scope.prefix);
+  result.set("last_declarator", scope.last_declarator);
+  result.set("compound_counter", scope.compound_counter);
+  result.set("anon_counter", scope.anon_counter);
+
+  irept &names = result.add("names");
+  for(const auto &entry : scope.name_map)
+  {
+    irept name(entry.first);
+    name.set("class", static_cast<int>(entry.second.id_class));
+    name.set("base_name", entry.second.base_name);
+    name.set("prefixed_name", entry.second.prefixed_name);
+    names.get_sub().push_back(name);
+  }
+
+  return result;
+}
+
+static void irep_to_scope(const irept &irep, ansi_c_scopet &scope)
+{
+  scope.prefix = irep.get_string("prefix");
+  scope.last_declarator = irep.get("last_declarator");
+  scope.compound_counter =
+    static_cast<unsigned>(irep.get_size_t("compound_counter"));
+  scope.anon_counter = static_cast<unsigned>(irep.get_size_t("anon_counter"));
+
+  for(const auto &name : irep.find("names").get_sub())
+  {
+    ansi_c_identifiert &identifier = scope.name_map[name.id()];
+    identifier.id_class = static_cast<ansi_c_id_classt>(name.get_int("class"));
+    identifier.base_name = name.get("base_name");
+    identifier.prefixed_name = name.get("prefixed_name");
+  }
+}
+
+/// Parse and type check \p code on its own, as ansi_c_languaget would
+/// \return true on error
+static bool
+build(const std::string &code, precompiled_internal_additionst &dest)
+{
+  null_message_handlert null_message_handler;
+  std::istringstream codestr(code);
+
+  ansi_c_parser.clear();
+  ansi_c_parser.set_file(ID_built_in);
+  ansi_c_parser.in = &codestr;
+  ansi_c_parser.set_message_handler(null_message_handler);
+  ansi_c_parser.for_has_scope = config.ansi_c.for_has_scope;
+  ansi_c_parser.ts_18661_3_Floatn_types = config.ansi_c.ts_18661_3_Floatn_types;
+  ansi_c_parser.cpp98 = false;
+  ansi_c_parser.cpp11 = false;
+  ansi_c_parser.mode = config.ansi_c.mode;
+
+  ansi_c_scanner_init();
+
+  const bool parse_failed = ansi_c_parser.parse();
+
+  ansi_c_parse_treet parse_tree;
+  parse_tree.swap(ansi_c_parser.parse_tree);
+  dest.scope = ansi_c_parser.root_scope();
+  ansi_c_parser.clear();
+
+  if(parse_failed)
+    return true;
+
+  return ansi_c_typecheck(
+    parse_tree, dest.symbol_table, "", null_message_handler);
+}
+
+/// \return true on error
+static bool read(
+  std::istream &in,
+  const std::string &path,
+  precompiled_internal_additionst &dest)
+{
+  null_message_handlert null_message_handler;
+  goto_functionst goto_functions;
+  if(read_bin_goto_object(
+       in, path, dest.symbol_table, goto_functions, null_message_handler))
+  {
+    return true;
+  }
+
+  // the scope follows the symbol table
+  try
+  {
+    irep_serializationt::ireps_containert ireps_container;
+    irep_serializationt irep_serialization(ireps_container);
+    irep_to_scope(irep_serialization.reference_convert(in), dest.scope);
+  }
+  catch(const deserialization_exceptiont &)
+  {
+    return true;
+  }
+
+  return !in;
+}
+
+/// \return true on error
+static bool
+write(std::ostream &out, const precompiled_internal_additionst &additions)
+{
+  if(write_goto_binary(out, additions.symbol_table, goto_functionst()))
+    return true;
+
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt irep_serialization(ireps_container);
+  irep_serialization.reference_convert(scope_to_irep(additions.scope), out);
+
+  return !out;
+}
+
+const precompiled_internal_additionst *get_precompiled_internal_additions(
+  const std::string &code,
+  message_handlert &message_handler)
+{
+  const std::string configuration = get_configuration(code);
+  const std::string path =
+    precompiled_cache_file("internal_additions", configuration);
+  if(path.empty())
+    return nullptr;
+
+  static std::map<std::string, std::unique_ptr<precompiled_internal_additionst>>
+    cache;
+
+  auto entry = cache.find(configuration);
+  if(entry != cache.end())
+    return entry->second.get();
+
+  std::unique_ptr<precompiled_internal_additionst> &additions =
+    cache[configuration];
+  additions = std::unique_ptr<precompiled_internal_additionst>(
+    new precompiled_internal_additionst());
+
+  messaget log(message_handler);
+
+  if(file_exists(path))
+  {
+    precompiled_internal_additionst &result = *additions;
+    if(!read_precompiled_cache_file(
+         path, configuration, [&path, &result](std::istream &in) {
+           return read(in, path, result);
+         }))
+    {
+      log.debug() << "Using precompiled internal additions " << path
+                  << messaget::eom;
+      return additions.get();
+    }
+
+    log.warning() << "failed to read precompiled internal additions '" << path
+                  << "', rebuilding them" << messaget::eom;
+    additions = std::unique_ptr<precompiled_internal_additionst>(
+      new precompiled_internal_additionst());
+  }
+
+  log.status() << "Building precompiled internal additions " << path
+               << messaget::eom;
+
+  if(build(code, *additions))
+  {
+    // remembered as nullptr, the caller reports the errors
+    additions.reset();
+    return nullptr;
+  }
+
+  const precompiled_internal_additionst &result = *additions;
+  if(write_precompiled_cache_file(
+       path, configuration, [&result](std::ostream &out) {
+         return write(out, result);
+       }))
+  {
+    log.warning() << "failed to write precompiled internal additions '"
+                  << path << "'" << messaget::eom;
+  }
+
+  return additions.get();
+}
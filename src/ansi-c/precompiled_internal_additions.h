@@ -0,0 +1,43 @@
+/*******************************************************************\
+
+Module: Precompiled Internal Additions
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// The internal additions that precede each C file, parsed and type-checked
+/// once per configuration
+
+#ifndef CPROVER_ANSI_C_PRECOMPILED_INTERNAL_ADDITIONS_H
+#define CPROVER_ANSI_C_PRECOMPILED_INTERNAL_ADDITIONS_H
+
+#include <string>
+
+#include <util/symbol_table.h>
+
+#include "ansi_c_scope.h"
+
+class message_handlert;
+
+/// The result of parsing and type checking the internal additions on their
+/// own: the global scope of the parser, which holds the typedef names that
+/// the parser of the C file needs to know, and the symbols of the additions.
+struct precompiled_internal_additionst
+{
+  ansi_c_scopet scope;
+  symbol_tablet symbol_table;
+};
+
+/// Get the internal additions given by \p code in precompiled form. They are
+/// read from the directory given in the environment variable
+/// CPROVER_LIBRARY_CACHE, or built and stored there if that directory does
+/// not hold them yet. Each configuration is loaded at most once per process.
+/// \return nullptr if CPROVER_LIBRARY_CACHE is not set or \p code fails to
+///   type check, in which case the caller processes \p code as usual
+const precompiled_internal_additionst *get_precompiled_internal_additions(
+  const std::string &code,
+  message_handlert &message_handler);
+
+#endif // CPROVER_ANSI_C_PRECOMPILED_INTERNAL_ADDITIONS_H
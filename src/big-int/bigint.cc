@@ -277,9 +277,17 @@ digit_div (onedig_t *r, const onedig_t *y, unsigned yl, onedig_t *q, unsigned ql
 inline void
 BigInt::allocate (unsigned digits)
 {
-  size = adjust_size (digits);
   length = 0;
-  digit = new onedig_t[size];
+  if (digits <= small + 1)
+    {
+      size = small + 1;
+      digit = local_digit;
+    }
+  else
+    {
+      size = adjust_size (digits);
+      digit = new onedig_t[size];
+    }
 }
 
 
@@ -291,7 +299,7 @@ BigInt::reallocate (unsigned digits)
 {
   if (digits > size)
     {
-      if (size)
+      if (size && !is_local())
 	delete[] digit;
       size = adjust_size (digits);
       digit = new onedig_t[size];
@@ -313,7 +321,7 @@ BigInt::resize (unsigned digits)
       if (old_digit)
 	{
 	  memcpy (digit, old_digit, length * sizeof (onedig_t));
-	  if (old_size)
+	  if (old_size && old_digit != local_digit)
 	    delete[] old_digit;
 	}
     }
@@ -386,7 +394,7 @@ BigInt::assign (llong_t l)
 
 BigInt::~BigInt()
 {
-  if (size > 0)
+  if (size > 0 && !is_local())
     {
       memset (digit, 0, size * sizeof digit[0]); // Crypto-paranoia.
       delete[] digit;
@@ -401,66 +409,65 @@ BigInt::BigInt (onedig_t *dig, unsigned len, bool pos)
 {}
 
 BigInt::BigInt()
-  : size (adjust_size (small)),
+  : size (small + 1),
     length (0),
-    digit (new onedig_t[size]),
+    digit (local_digit),
     positive (true)
 {}
 
 BigInt::BigInt (signed long int n)
-  : size (adjust_size (small)),
+  : size (small + 1),
     length (0),
-    digit (new onedig_t[size])
+    digit (local_digit)
 {
   assign (llong_t (n));
 }
 
 BigInt::BigInt (unsigned long int n)
-  : size (adjust_size (small)),
+  : size (small + 1),
     length (0),
-    digit (new onedig_t[size])
+    digit (local_digit)
 {
   assign (ullong_t (n));
 }
 
 BigInt::BigInt (int n)
-  : size (adjust_size (small)),
+  : size (small + 1),
     length (0),
-    digit (new onedig_t[size])
+    digit (local_digit)
 {
   assign (llong_t (n));
 }
 
 BigInt::BigInt (unsigned u)
-  : size (adjust_size (small)),
+  : size (small + 1),
     length (0),
-    digit (new onedig_t[size])
+    digit (local_digit)
 {
   assign (ullong_t (u));
 }
 
 BigInt::BigInt (llong_t l)
-  : size (adjust_size (small)),
+  : size (small + 1),
     length (0),
-    digit (new onedig_t[size])
+    digit (local_digit)
 {
   assign (l);
 }
 
 BigInt::BigInt (ullong_t ul)
-  : size (adjust_size (small)),
+  : size (small + 1),
     length (0),
-    digit (new onedig_t[size])
+    digit (local_digit)
 {
   assign (ul);
 }
 
 BigInt::BigInt (BigInt const &y)
-  : size (adjust_size (y.length)),
-    length (y.length),
-    digit (new onedig_t[size]),
-    positive (y.positive)
+  : positive (y.positive)
 {
+  allocate (y.length);
+  length = y.length;
   memcpy (digit, y.digit, length * sizeof (onedig_t));
 }
 
@@ -471,9 +478,9 @@ BigInt::BigInt (BigInt &&y)
 }
 
 BigInt::BigInt (char const *s, onedig_t b)
-  : size (adjust_size (small)),
+  : size (small + 1),
     length (0),
-    digit (new onedig_t[size]),
+    digit (local_digit),
     positive (true)
 {
   scan (s, b);
@@ -885,7 +892,7 @@ BigInt::mul (onedig_t const *dig, unsigned len, bool pos)
 	digit_mul (dig, len, digit, length, r);
 
       // Replace digit string of this with result.
-      if (old_size)
+      if (old_size && !is_local())
 	delete[] digit;
       digit = r;
       length += len;
@@ -134,6 +134,15 @@ private:
   onedig_t *digit;			// Least significant first.
   bool positive;			// Signed magnitude representation.
 
+  // Not part of original BigInt.
+  // Numbers that fit into an ullong_t, which is most of them, are kept
+  // in this buffer rather than on the heap, such that creating, copying
+  // and destroying them does not allocate. The digit vector is moved to
+  // the heap once it would outgrow the buffer.
+  onedig_t local_digit[small + 1];
+
+  bool is_local() const			{ return digit == local_digit; }
+
   // Create or resize this.
   inline void allocate (unsigned digits);
   inline void reallocate (unsigned digits);
@@ -283,10 +292,19 @@ public:
 
   void swap (BigInt &other)
   {
+    // Digit vectors in the local buffers are swapped by copying them,
+    // those on the heap by swapping the pointers.
+    const bool local = is_local();
+    const bool other_local = other.is_local();
     std::swap(other.size, size);
     std::swap(other.length, length);
     std::swap(other.digit, digit);
     std::swap(other.positive, positive);
+    std::swap(other.local_digit, local_digit);
+    if (local)
+      other.digit = other.local_digit;
+    if (other_local)
+      digit = local_digit;
   }
 };
 
@@ -34,6 +34,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <cpp/cprover_library.h>
 
+#include <goto-checker/adaptive_unwinding_verifier.h>
 #include <goto-checker/all_properties_verifier.h>
 #include <goto-checker/all_properties_verifier_with_fault_localization.h>
 #include <goto-checker/all_properties_verifier_with_trace_storage.h>
@@ -240,6 +241,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("drop-unused-functions"))
     options.set_option("drop-unused-functions", true);
 
+  if(cmdline.isset("lazy-functions"))
+    options.set_option("lazy-functions", true);
+
   if(cmdline.isset("string-abstraction"))
     options.set_option("string-abstraction", true);
 
@@ -328,6 +332,28 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("slice-formula"))
     options.set_option("slice-formula", true);
 
+  // convert the equation while symex produces it
+  if(cmdline.isset("stream-equation"))
+  {
+    if(cmdline.isset("slice-formula"))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "--stream-equation cannot be combined with --slice-formula",
+        "--stream-equation");
+    }
+
+    // only the multi-path checker streams the equation
+    if(cmdline.isset("paths") || cmdline.isset("incremental-loop"))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "--stream-equation cannot be combined with --paths or "
+        "--incremental-loop",
+        "--stream-equation");
+    }
+
+    options.set_option("stream-equation", true);
+  }
+
   // simplify if conditions and branches
   if(cmdline.isset("no-simplify-if"))
     options.set_option("simplify-if", false);
@@ -394,6 +420,34 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     }
   }
 
+  if(cmdline.isset("adaptive-unwind"))
+  {
+    if(!cmdline.isset("unwind-max"))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "--adaptive-unwind requires a maximum bound", "--unwind-max");
+    }
+
+    if(
+      cmdline.isset("incremental-loop") || cmdline.isset("paths") ||
+      cmdline.isset("stop-on-fail") || cmdline.isset("partial-loops"))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "--adaptive-unwind cannot be combined with --incremental-loop, "
+        "--paths, --stop-on-fail or --partial-loops",
+        "--adaptive-unwind");
+    }
+
+    options.set_option("adaptive-unwind", true);
+    // the unwinding assertions are checked to choose the bounds, but are
+    // not part of the results if the user does not want them
+    if(cmdline.isset("no-unwinding-assertions"))
+      options.set_option("no-unwinding-assertions", true);
+    options.set_option("unwind-max", cmdline.get_value("unwind-max"));
+    if(!cmdline.isset("unwind"))
+      options.set_option("unwind", 1);
+  }
+
   // SMT Options
 
   if(cmdline.isset("smt1"))
@@ -683,7 +737,13 @@ int cbmc_parse_optionst::doit()
 
   std::unique_ptr<goto_verifiert> verifier = nullptr;
 
-  if(options.is_set("incremental-loop"))
+  if(options.get_bool_option("adaptive-unwind"))
+  {
+    verifier =
+      util_make_unique<adaptive_unwinding_verifiert<multi_path_symex_checkert>>(
+        options, ui_message_handler, goto_model);
+  }
+  else if(options.is_set("incremental-loop"))
   {
     if(options.get_bool_option("stop-on-fail"))
     {
@@ -1071,6 +1131,8 @@ void cbmc_parse_optionst::help()
     HELP_REACHABILITY_SLICER_FB
     " --full-slice                 run full slicer (experimental)\n" // NOLINT(*)
     " --drop-unused-functions      drop functions trivially unreachable from main function\n" // NOLINT(*)
+    " --lazy-functions             only convert functions that the entry point\n" // NOLINT(*)
+    "                              calls or takes the address of, transitively\n" // NOLINT(*)
     "\n"
     "Semantic transformations:\n"
     // NOLINTNEXTLINE(whitespace/line_length)
@@ -244,6 +244,23 @@ void cpp_typecheckt::elaborate_class_template(
   }
 }
 
+const symbolt *
+cpp_typecheckt::complete_instance(const irep_idt &identifier) const
+{
+  const symbolt *symbol = symbol_table.lookup(identifier);
+  if(symbol == nullptr)
+    return nullptr;
+
+  if(
+    (symbol->is_type && symbol->type.id() == ID_struct) ||
+    (!symbol->is_type && symbol->value.is_not_nil()))
+  {
+    return symbol;
+  }
+
+  return nullptr;
+}
+
 /// \par parameters: location of the instantiation,
 /// the identifier of the template symbol,
 /// typechecked template arguments,
@@ -313,6 +330,18 @@ const symbolt &cpp_typecheckt::instantiate_template(
   // produce new symbol name
   std::string suffix=template_suffix(full_template_args);
 
+  // instantiated before?
+  const std::string instance_key = id2string(template_symbol.name) + suffix;
+  {
+    const auto entry = instantiations.find(instance_key);
+    if(entry != instantiations.end())
+    {
+      const symbolt *instance = complete_instance(entry->second);
+      if(instance != nullptr)
+        return *instance;
+    }
+  }
+
   // we need the template scope to see the template parameters
   cpp_scopet *template_scope=
     static_cast<cpp_scopet *>(cpp_scopes.id_map[template_symbol.name]);
@@ -377,9 +406,15 @@ const symbolt &cpp_typecheckt::instantiate_template(
       // continue if the type is incomplete only
       if(cpp_id.id_class==cpp_idt::id_classt::CLASS &&
          symb.type.id()==ID_struct)
+      {
+        instantiations[instance_key] = symb.name;
         return symb;
+      }
       else if(symb.value.is_not_nil())
+      {
+        instantiations[instance_key] = symb.name;
         return symb;
+      }
     }
 
     cpp_scopes.go_to(sub_scope);
@@ -476,6 +511,7 @@ const symbolt &cpp_typecheckt::instantiate_template(
     std::cout << "template type: " << template_type.pretty() << "\n\n";
 #endif
 
+    instantiations[instance_key] = new_symb.name;
     return new_symb;
   }
 
@@ -527,7 +563,10 @@ const symbolt &cpp_typecheckt::instantiate_template(
       false,
       false);
 
-    return lookup(to_struct_type(symb.type).components().back().get_name());
+    const symbolt &method =
+      lookup(to_struct_type(symb.type).components().back().get_name());
+    instantiations[instance_key] = method.name;
+    return method;
   }
 
   // not a class template, not a class template method,
@@ -540,5 +579,6 @@ const symbolt &cpp_typecheckt::instantiate_template(
   const symbolt &symb=
     lookup(new_decl.declarators()[0].get(ID_identifier));
 
+  instantiations[instance_key] = symb.name;
   return symb;
 }
@@ -94,13 +94,27 @@ bool cpp_languaget::parse(
 
   std::ostringstream o_preprocessed;
 
-  cpp_internal_additions(o_preprocessed);
-
   if(preprocess(instream, path, o_preprocessed))
     return true;
 
   std::istringstream i_preprocessed(o_preprocessed.str());
 
+  return parse_preprocessed(i_preprocessed, path);
+}
+
+bool cpp_languaget::parse_preprocessed(
+  std::istream &instream,
+  const std::string &path)
+{
+  parse_path=path;
+
+  std::ostringstream o_preprocessed;
+
+  cpp_internal_additions(o_preprocessed);
+  o_preprocessed << instream.rdbuf();
+
+  std::istringstream i_preprocessed(o_preprocessed.str());
+
   // parsing
 
   cpp_parser.clear();
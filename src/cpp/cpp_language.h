@@ -39,6 +39,9 @@ public:
     std::istream &instream,
     const std::string &path) override;
 
+  bool parse_preprocessed(std::istream &instream, const std::string &path)
+    override;
+
   bool generate_support_functions(
     symbol_tablet &symbol_table) override;
 
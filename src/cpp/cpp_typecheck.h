@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@cs.cmu.edu
 #include <list>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <util/std_code.h>
@@ -222,6 +223,17 @@ protected:
     const source_locationt &source_location,
     const struct_tag_typet &type);
 
+  /// Symbols of the complete instances of templates, by identifier of the
+  /// template symbol followed by the template_suffix of the arguments, so
+  /// that repeated instantiations are answered before any scope or
+  /// declaration is set up
+  std::unordered_map<std::string, irep_idt> instantiations;
+
+  /// \return the instance \p identifier if it is complete, i.e., a class
+  ///   that has been elaborated or a function or member that has a value;
+  ///   nullptr otherwise
+  const symbolt *complete_instance(const irep_idt &identifier) const;
+
   unsigned template_counter;
   unsigned anon_counter;
 
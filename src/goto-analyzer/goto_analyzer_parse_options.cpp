@@ -11,10 +11,12 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "goto_analyzer_parse_options.h"
 
+#include <algorithm>
 #include <cstdlib> // exit()
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <thread>
 
 #include <ansi-c/ansi_c_language.h>
 #include <ansi-c/cprover_library.h>
@@ -253,6 +255,19 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
     // Abstract interpreter choice
     if(cmdline.isset("recursive-interprocedural"))
       options.set_option("recursive-interprocedural", true);
+    else if(cmdline.isset("parallel-interprocedural"))
+    {
+      if(cmdline.isset("one-domain-per-history"))
+      {
+        throw invalid_command_line_argument_exceptiont(
+          "--parallel-interprocedural requires one domain per location",
+          "--one-domain-per-history");
+      }
+
+      options.set_option("parallel-interprocedural", true);
+      options.set_option("one-domain-per-location", true);
+      options.set_option("storage set", true);
+    }
     else if(cmdline.isset("legacy-ait") || cmdline.isset("location-sensitive"))
     {
       options.set_option("legacy-ait", true);
@@ -371,6 +386,77 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("storage set", true);
   }
 
+  // Widening choice
+  if(cmdline.isset("widening-delay"))
+    options.set_option("widening-delay", cmdline.get_value("widening-delay"));
+
+  if(cmdline.isset("narrowing-passes"))
+  {
+    if(
+      !options.get_bool_option("one-domain-per-location") ||
+      options.get_bool_option("one-domain-per-history") ||
+      options.get_bool_option("legacy-concurrent"))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "narrowing requires one domain per location and is not supported by "
+        "--legacy-concurrent",
+        "--narrowing-passes");
+    }
+
+    options.set_option(
+      "narrowing-passes", cmdline.get_value("narrowing-passes"));
+  }
+
+  if(cmdline.isset("sparse-states"))
+  {
+    if(
+      !options.get_bool_option("recursive-interprocedural") ||
+      !options.get_bool_option("one-domain-per-location") ||
+      options.get_bool_option("one-domain-per-history") ||
+      cmdline.isset("narrowing-passes"))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "sparse states require --recursive-interprocedural and "
+        "--one-domain-per-location and are not supported with narrowing",
+        "--sparse-states");
+    }
+
+    options.set_option("sparse-states", true);
+  }
+
+  if(cmdline.isset("modular"))
+  {
+    if(!options.get_bool_option("verify"))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "functions are only verified on their own for --verify", "--modular");
+    }
+
+    // these only follow calls when analysing the whole program
+    if(
+      options.get_bool_option("parallel-interprocedural") ||
+      options.get_bool_option("legacy-concurrent"))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "analysing functions on their own is not supported with "
+        "--parallel-interprocedural or --legacy-concurrent",
+        "--modular");
+    }
+
+    options.set_option("modular", true);
+  }
+
+  if(cmdline.isset("cache-dir"))
+  {
+    if(!options.get_bool_option("verify"))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "results are only cached for --verify", "--cache-dir");
+    }
+
+    options.set_option("cache-dir", cmdline.get_value("cache-dir"));
+  }
+
   if(cmdline.isset("validate-goto-model"))
   {
     options.set_option("validate-goto-model", true);
@@ -385,7 +471,9 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
   const namespacet &ns)
 {
   // These support all of the option categories
-  if(options.get_bool_option("recursive-interprocedural"))
+  if(
+    options.get_bool_option("recursive-interprocedural") ||
+    options.get_bool_option("parallel-interprocedural"))
   {
     // Build the history factory
     std::unique_ptr<ai_history_factory_baset> hf = nullptr;
@@ -409,8 +497,7 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
     }
     else if(options.get_bool_option("intervals"))
     {
-      df = util_make_unique<
-        ai_domain_factory_default_constructort<interval_domaint>>();
+      df = util_make_unique<interval_domain_factoryt>();
     }
     // non-null is not fully supported, despite the historical options
     // dependency-graph is quite heavily tied to the legacy-ait infrastructure
@@ -435,6 +522,14 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
         return new ai_recursive_interproceduralt(
           std::move(hf), std::move(df), std::move(st));
       }
+      else if(options.get_bool_option("parallel-interprocedural"))
+      {
+        return new ai_parallel_interproceduralt(
+          std::move(hf),
+          std::move(df),
+          std::move(st),
+          std::max(std::thread::hardware_concurrency(), 1u));
+      }
       UNREACHABLE;
     }
   }
@@ -451,7 +546,8 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
     }
     else if(options.get_bool_option("intervals"))
     {
-      return new ait<interval_domaint>();
+      return new ait<interval_domaint>(
+        util_make_unique<interval_domain_factoryt>());
     }
 #if 0
     // Not actually implemented, despite the option...
@@ -542,18 +638,28 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
   adjust_float_expressions(goto_model);
   if(options.get_bool_option("taint"))
   {
-    std::string taint_file=cmdline.get_value("taint");
+    const std::list<std::string> &taint_files = cmdline.get_values("taint");
+    const std::size_t number_of_threads =
+      std::max(std::thread::hardware_concurrency(), 1u);
 
     if(cmdline.isset("show-taint"))
     {
-      taint_analysis(goto_model, taint_file, ui_message_handler, true);
+      taint_analysis(
+        goto_model, taint_files, ui_message_handler, true, {}, 1);
       return CPROVER_EXIT_SUCCESS;
     }
     else
     {
-      std::string json_file=cmdline.get_value("json");
+      optionalt<std::string> json_file;
+      if(cmdline.isset("json"))
+        json_file = cmdline.get_value("json");
       bool result = taint_analysis(
-        goto_model, taint_file, ui_message_handler, false, json_file);
+        goto_model,
+        taint_files,
+        ui_message_handler,
+        false,
+        json_file,
+        number_of_threads);
       return result ? CPROVER_EXIT_VERIFICATION_UNSAFE : CPROVER_EXIT_SUCCESS;
     }
   }
@@ -693,9 +799,42 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
       return CPROVER_EXIT_INTERNAL_ERROR;
     }
 
+    if(options.is_set("widening-delay"))
+    {
+      analyzer->set_widening_delay(
+        options.get_unsigned_int_option("widening-delay"));
+    }
+
+    if(options.is_set("narrowing-passes"))
+    {
+      analyzer->set_narrowing_passes(
+        options.get_unsigned_int_option("narrowing-passes"));
+    }
+
+    if(options.get_bool_option("sparse-states"))
+      analyzer->set_sparse_states(true);
+
+    if(options.get_bool_option("modular"))
+    {
+      return static_verifier_modular(
+               goto_model, *analyzer, options, ui_message_handler, out)
+               ? CPROVER_EXIT_VERIFICATION_UNSAFE
+               : CPROVER_EXIT_VERIFICATION_SAFE;
+    }
+
+    if(options.is_set("cache-dir"))
+    {
+      return static_verifier_cached(
+               goto_model, *analyzer, options, ui_message_handler, out)
+               ? CPROVER_EXIT_VERIFICATION_UNSAFE
+               : CPROVER_EXIT_VERIFICATION_SAFE;
+    }
+
     // Run
     log.status() << "Computing abstract states" << messaget::eom;
     (*analyzer)(goto_model);
+    log.statistics() << "Abstract interpretation took "
+                     << analyzer->get_steps() << " steps" << messaget::eom;
 
     // Perform the task
     log.status() << "Performing task" << messaget::eom;
@@ -843,9 +982,15 @@ void goto_analyzer_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     " --recursive-interprocedural  use recursion to handle interprocedural reasoning\n"
     // NOLINTNEXTLINE(whitespace/line_length)
+    " --parallel-interprocedural   analyse functions in parallel, merging all calling contexts\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
     " --legacy-ait                 recursion for function and one domain per location\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     " --legacy-concurrent          legacy-ait with an extended fixed-point for concurrency\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --modular                    verify each function from its own entry rather\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              than from the calling contexts in the program\n"
     "\n"
     "History options:\n"
     // NOLINTNEXTLINE(whitespace/line_length)
@@ -865,6 +1010,19 @@ void goto_analyzer_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     " --one-domain-per-history     stores a domain for each history object created\n"
     " --one-domain-per-location    stores a domain for each location reached\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --sparse-states              only keep domains at joins, calls and returns,\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              recomputing the others when needed, requires\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              --recursive-interprocedural and --one-domain-per-location\n"
+    "\n"
+    "Widening options:\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --widening-delay n           widen at loop heads after n merges (intervals)\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --narrowing-passes n         refine the result by n descending iterations,\n"
+    "                              requires --one-domain-per-location\n"
     "\n"
     "Output options:\n"
     " --text file_name             output results in plain text to given file\n"
@@ -872,10 +1030,20 @@ void goto_analyzer_parse_optionst::help()
     " --json file_name             output results in JSON format to given file\n"
     " --xml file_name              output results in XML format to given file\n"
     " --dot file_name              output results in DOT format to given file\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --cache-dir dir              store the results of --verify in dir and reuse\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              them while the program and options are unchanged;\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              with --modular, per function and its callees\n"
     "\n"
     "Specific analyses:\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     " --taint file_name            perform taint analysis using rules in given file\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              (may be given several times to check several\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              rule sets in one run, reported per rule set)\n"
     "\n"
     "C/C++ frontend options:\n"
     " -I path                      set include path (C/C++)\n"
@@ -115,8 +115,10 @@ class optionst;
 
 #define GOTO_ANALYSER_OPTIONS_AI \
   "(recursive-interprocedural)" \
+  "(parallel-interprocedural)" \
   "(legacy-ait)" \
-  "(legacy-concurrent)"
+  "(legacy-concurrent)" \
+  "(modular)"
 
 #define GOTO_ANALYSER_OPTIONS_HISTORY \
   "(ahistorical)" \
@@ -130,11 +132,17 @@ class optionst;
 
 #define GOTO_ANALYSER_OPTIONS_STORAGE \
   "(one-domain-per-history)" \
-  "(one-domain-per-location)"
+  "(one-domain-per-location)" \
+  "(sparse-states)"
+
+#define GOTO_ANALYSER_OPTIONS_WIDENING \
+  "(widening-delay):" \
+  "(narrowing-passes):"
 
 #define GOTO_ANALYSER_OPTIONS_OUTPUT \
   "(json):(xml):" \
-  "(text):(dot):"
+  "(text):(dot):" \
+  "(cache-dir):"
 
 #define GOTO_ANALYSER_OPTIONS_SPECIFIC_ANALYSES \
   "(taint):(show-taint)" \
@@ -165,6 +173,7 @@ class optionst;
   GOTO_ANALYSER_OPTIONS_HISTORY \
   GOTO_ANALYSER_OPTIONS_DOMAIN \
   GOTO_ANALYSER_OPTIONS_STORAGE \
+  GOTO_ANALYSER_OPTIONS_WIDENING \
   GOTO_ANALYSER_OPTIONS_OUTPUT \
   GOTO_ANALYSER_OPTIONS_SPECIFIC_ANALYSES \
 // clang-format on
@@ -8,15 +8,27 @@ Author: Martin Brain, martin.brain@cs.ox.ac.uk
 
 #include "static_verifier.h"
 
+#include <util/file_util.h>
+#include <util/irep_serialization.h>
 #include <util/json_irep.h>
 #include <util/message.h>
 #include <util/namespace.h>
 #include <util/options.h>
 #include <util/range.h>
+#include <util/string_hash.h>
+#include <util/version.h>
 
 #include <goto-programs/goto_model.h>
 
 #include <analyses/ai.h>
+#include <analyses/call_graph_helpers.h>
+
+#include <json/json_parser.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
 
 struct static_verifier_resultt
 {
@@ -287,171 +299,129 @@ check_assertion(const ai_domain_baset &domain, exprt e, const namespacet &ns)
   UNREACHABLE;
 }
 
-/// Runs the analyzer and then prints out the domain
-/// \param goto_model: the program analyzed
-/// \param ai: the abstract interpreter after it has been run to fix point
-/// \param options: the parsed user options
-/// \param message_handler: the system message handler
-/// \param out: output stream for the printing
-/// \return false on success with the domain printed to out
-bool static_verifier(
-  const goto_modelt &goto_model,
+/// Check one assertion using all histories that reach it
+static static_verifier_resultt::statust check_assertion(
   const ai_baset &ai,
-  const optionst &options,
-  message_handlert &message_handler,
-  std::ostream &out)
+  goto_programt::const_targett i_it,
+  const namespacet &ns)
 {
-  std::size_t pass = 0, fail = 0, unknown = 0;
+  const exprt &e = i_it->get_condition();
 
-  namespacet ns(goto_model.symbol_table);
+  // If there are multiple, distinct histories that reach the same location
+  // we can get better results by checking with each individually rather
+  // than merging all of them and doing one check.
+  const auto trace_set_pointer =
+    ai.abstract_traces_before(i_it); // Keep a pointer so refcount > 0
+  const auto &trace_set = *trace_set_pointer;
 
-  messaget m(message_handler);
-  m.status() << "Checking assertions" << messaget::eom;
+  if(trace_set.size() == 0) // i.e. unreachable
+    return static_verifier_resultt::BOTTOM;
+  else if(trace_set.size() == 1)
+    return check_assertion(*ai.abstract_state_before(i_it), e, ns);
 
-  std::vector<static_verifier_resultt> results;
+  // Multiple traces, verify against each one
+  std::size_t unreachable_traces = 0;
+  std::size_t true_traces = 0;
+  std::size_t false_traces = 0;
+  std::size_t unknown_traces = 0;
 
-  for(const auto &f : goto_model.goto_functions.function_map)
+  for(const auto &trace_ptr : trace_set)
   {
-    const auto &symbol = ns.lookup(f.first);
-
-    m.progress() << "Checking " << symbol.display_name() << messaget::eom;
-
-    if(!f.second.body.has_assertion())
-      continue;
+    switch(check_assertion(*ai.abstract_state_before(trace_ptr), e, ns))
+    {
+    case static_verifier_resultt::BOTTOM:
+      ++unreachable_traces;
+      break;
+    case static_verifier_resultt::TRUE:
+      ++true_traces;
+      break;
+    case static_verifier_resultt::FALSE:
+      ++false_traces;
+      break;
+    case static_verifier_resultt::UNKNOWN:
+      ++unknown_traces;
+      break;
+    }
+  }
 
-    forall_goto_program_instructions(i_it, f.second.body)
+  // Join the results
+  if(unknown_traces != 0)
+  {
+    // If any trace is unknown, the final result must be unknown
+    return static_verifier_resultt::UNKNOWN;
+  }
+  else if(false_traces == 0)
+  {
+    // Definitely true; the only question is how
+    if(true_traces == 0)
     {
-      if(!i_it->is_assert())
-        continue;
+      // Definitely not reachable
+      INVARIANT(
+        unreachable_traces == trace_set.size(),
+        "All traces must not reach the assertion");
+      return static_verifier_resultt::BOTTOM;
+    }
 
-      exprt e(i_it->get_condition());
+    // At least one trace (may) reach it.
+    // All traces that reach it are safe.
+    return static_verifier_resultt::TRUE;
+  }
 
-      results.push_back(static_verifier_resultt());
-      auto &result = results.back();
+  // At least one trace (may) reach it and it is false on that trace. If
+  // there also are traces on which it is true, it is not entirely fair to say
+  // "FAILURE (if reachable)" because it's a bit more complex than that,
+  // "FAILURE (if reachable via a particular trace)" would be more accurate
+  // summary of what we know at this point. Given that all results of FAILURE
+  // from this analysis are caveated with some reachability questions, the
+  // following is not entirely unreasonable.
+  return static_verifier_resultt::FALSE;
+}
 
-      // If there are multiple, distinct histories that reach the same location
-      // we can get better results by checking with each individually rather
-      // than merging all of them and doing one check.
-      const auto trace_set_pointer =
-        ai.abstract_traces_before(i_it); // Keep a pointer so refcount > 0
-      const auto &trace_set = *trace_set_pointer;
+/// Check the assertions in \p goto_program, the body of \p function_id
+static void check_assertions(
+  const ai_baset &ai,
+  const irep_idt &function_id,
+  const goto_programt &goto_program,
+  const namespacet &ns,
+  std::vector<static_verifier_resultt> &results)
+{
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    if(!i_it->is_assert())
+      continue;
 
-      if(trace_set.size() == 0) // i.e. unreachable
-      {
-        result.status = static_verifier_resultt::BOTTOM;
-        ++pass;
-      }
-      else if(trace_set.size() == 1)
-      {
-        auto dp = ai.abstract_state_before(i_it);
-
-        result.status = check_assertion(*dp, e, ns);
-        switch(result.status)
-        {
-        case static_verifier_resultt::BOTTOM:
-          ++pass;
-          break;
-        case static_verifier_resultt::TRUE:
-          ++pass;
-          break;
-        case static_verifier_resultt::FALSE:
-          ++fail;
-          break;
-        case static_verifier_resultt::UNKNOWN:
-          ++unknown;
-          break;
-        default:
-          UNREACHABLE;
-        }
-      }
-      else
-      {
-        // Multiple traces, verify against each one
-        std::size_t unreachable_traces = 0;
-        std::size_t true_traces = 0;
-        std::size_t false_traces = 0;
-        std::size_t unknown_traces = 0;
-
-        for(const auto &trace_ptr : trace_set)
-        {
-          auto dp = ai.abstract_state_before(trace_ptr);
-
-          result.status = check_assertion(*dp, e, ns);
-          switch(result.status)
-          {
-          case static_verifier_resultt::BOTTOM:
-            ++unreachable_traces;
-            break;
-          case static_verifier_resultt::TRUE:
-            ++true_traces;
-            break;
-          case static_verifier_resultt::FALSE:
-            ++false_traces;
-            break;
-          case static_verifier_resultt::UNKNOWN:
-            ++unknown_traces;
-            break;
-          default:
-            UNREACHABLE;
-          }
-        }
-
-        // Join the results
-        if(unknown_traces != 0)
-        {
-          // If any trace is unknown, the final result must be unknown
-          result.status = static_verifier_resultt::UNKNOWN;
-          ++unknown;
-        }
-        else
-        {
-          if(false_traces == 0)
-          {
-            // Definitely true; the only question is how
-            ++pass;
-            if(true_traces == 0)
-            {
-              // Definitely not reachable
-              INVARIANT(
-                unreachable_traces == trace_set.size(),
-                "All traces must not reach the assertion");
-              result.status = static_verifier_resultt::BOTTOM;
-            }
-            else
-            {
-              // At least one trace (may) reach it.
-              // All traces that reach it are safe.
-              result.status = static_verifier_resultt::TRUE;
-            }
-          }
-          else
-          {
-            // At lease one trace (may) reach it and it is false on that trace
-            if(true_traces == 0)
-            {
-              // All traces that (may) reach it are false
-              ++fail;
-              result.status = static_verifier_resultt::FALSE;
-            }
-            else
-            {
-              // The awkward case, there are traces that (may) reach it and
-              // some are true, some are false.  It is not entirely fair to say
-              // "FAILURE (if reachable)" because it's a bit more complex than
-              // that, "FAILURE (if reachable via a particular trace)" would be
-              // more accurate summary of what we know at this point.
-              // Given that all results of FAILURE from this analysis are
-              // caveated with some reachability questions, the following is not
-              // entirely unreasonable.
-              ++fail;
-              result.status = static_verifier_resultt::FALSE;
-            }
-          }
-        }
-      }
+    results.push_back(static_verifier_resultt());
+    auto &result = results.back();
+    result.status = check_assertion(ai, i_it, ns);
+    result.source_location = i_it->source_location;
+    result.function_id = function_id;
+  }
+}
 
-      result.source_location = i_it->source_location;
-      result.function_id = f.first;
+/// Output the results in the format selected by the options and a summary
+static void static_verifier_report(
+  const std::vector<static_verifier_resultt> &results,
+  const namespacet &ns,
+  const optionst &options,
+  messaget &m,
+  std::ostream &out)
+{
+  std::size_t pass = 0, fail = 0, unknown = 0;
+
+  for(const auto &result : results)
+  {
+    switch(result.status)
+    {
+    case static_verifier_resultt::TRUE:
+    case static_verifier_resultt::BOTTOM:
+      ++pass;
+      break;
+    case static_verifier_resultt::FALSE:
+      ++fail;
+      break;
+    case static_verifier_resultt::UNKNOWN:
+      ++unknown;
+      break;
     }
   }
 
@@ -477,6 +447,368 @@ bool static_verifier(
              << fail << " fail if reachable, "
              << unknown << " unknown"
              << m.reset << messaget::eom;
+}
+
+/// A digest of the instructions of \p goto_program, written as in a goto
+/// binary
+static std::string function_digest(const goto_programt &goto_program)
+{
+  std::ostringstream out;
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt irep_serialization(ireps_container);
+
+  // jumps are written as offsets within the function, as the location
+  // numbers depend on the other functions
+  std::unordered_map<
+    goto_programt::const_targett,
+    std::size_t,
+    const_target_hash,
+    pointee_address_equalt>
+    offsets;
+  std::size_t offset = 0;
+  forall_goto_program_instructions(i_it, goto_program)
+    offsets[i_it] = offset++;
+
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    irep_serialization.reference_convert(i_it->code, out);
+    irep_serialization.reference_convert(i_it->source_location, out);
+    out << static_cast<int>(i_it->type) << ' ';
+    irep_serialization.reference_convert(i_it->guard, out);
+
+    for(const auto &target : i_it->targets)
+      out << offsets.at(target) << ' ';
+
+    out << '\n';
+  }
+
+  return string_digest(out.str());
+}
+
+static void write_cache(
+  const std::vector<static_verifier_resultt> &results,
+  const std::string &file_name,
+  messaget &m)
+{
+  const json_irept json_irep(true);
+  json_arrayt json_results;
+
+  for(const auto &result : results)
+  {
+    json_results.push_back(json_objectt{
+      {"function", json_stringt{result.function_id}},
+      {"status", json_stringt{message(result.status)}},
+      {"sourceLocation", json_irep.convert_from_irep(result.source_location)}});
+  }
+
+  std::ofstream out(file_name);
+  if(!out)
+  {
+    m.warning() << "failed to write analysis cache file '" << file_name << "'"
+                << messaget::eom;
+    return;
+  }
+
+  out << json_objectt{{"results", std::move(json_results)}};
+}
+
+/// Read the results stored by \ref write_cache
+/// \return true if the file does not exist or cannot be read
+static bool read_cache(
+  const std::string &file_name,
+  std::vector<static_verifier_resultt> &results)
+{
+  if(!file_exists(file_name))
+    return true;
+
+  // Treat malformed files as missing, and do not report parse errors
+  null_message_handlert null_message_handler;
+  jsont json;
+  if(parse_json(file_name, null_message_handler, json) || !json.is_object())
+    return true;
+
+  const jsont &json_results = to_json_object(json)["results"];
+  if(!json_results.is_array())
+    return true;
+
+  const json_irept json_irep(true);
+  const static_verifier_resultt::statust statuses[] = {
+    static_verifier_resultt::TRUE,
+    static_verifier_resultt::FALSE,
+    static_verifier_resultt::BOTTOM,
+    static_verifier_resultt::UNKNOWN};
+
+  for(const jsont &json_result : to_json_array(json_results))
+  {
+    if(!json_result.is_object())
+      return true;
+
+    const json_objectt &object = to_json_object(json_result);
+    static_verifier_resultt result;
+    result.function_id = object["function"].value;
+    const irept source_location =
+      json_irep.convert_from_json(object["sourceLocation"]);
+    result.source_location =
+      static_cast<const source_locationt &>(source_location);
+
+    const auto status = std::find_if(
+      std::begin(statuses),
+      std::end(statuses),
+      [&object](static_verifier_resultt::statust status) {
+        return object["status"].value == message(status);
+      });
+    if(status == std::end(statuses))
+      return true;
+    result.status = *status;
+
+    results.push_back(std::move(result));
+  }
+
+  return false;
+}
+
+/// Check the assertions of all functions of \p goto_model
+static void check_assertions(
+  const goto_modelt &goto_model,
+  const ai_baset &ai,
+  const namespacet &ns,
+  messaget &m,
+  std::vector<static_verifier_resultt> &results)
+{
+  for(const auto &f : goto_model.goto_functions.function_map)
+  {
+    const auto &symbol = ns.lookup(f.first);
+
+    m.progress() << "Checking " << symbol.display_name() << messaget::eom;
+
+    if(!f.second.body.has_assertion())
+      continue;
+
+    check_assertions(ai, f.first, f.second.body, ns, results);
+  }
+}
+
+/// Runs the analyzer and then prints out the domain
+/// \param goto_model: the program analyzed
+/// \param ai: the abstract interpreter after it has been run to fix point
+/// \param options: the parsed user options
+/// \param message_handler: the system message handler
+/// \param out: output stream for the printing
+/// \return false on success with the domain printed to out
+bool static_verifier(
+  const goto_modelt &goto_model,
+  const ai_baset &ai,
+  const optionst &options,
+  message_handlert &message_handler,
+  std::ostream &out)
+{
+  namespacet ns(goto_model.symbol_table);
+
+  messaget m(message_handler);
+  m.status() << "Checking assertions" << messaget::eom;
+
+  std::vector<static_verifier_resultt> results;
+  check_assertions(goto_model, ai, ns, m, results);
+
+  static_verifier_report(results, ns, options, m, out);
+
+  return false;
+}
+
+/// Create the cache directory given by the option "cache-dir"
+/// \return false if results cannot be stored there
+static bool open_cache_dir(const std::string &cache_dir, messaget &m)
+{
+  if(is_directory(cache_dir) || create_directory(cache_dir))
+    return true;
+
+  m.warning() << "failed to create analysis cache directory '" << cache_dir
+              << "'" << messaget::eom;
+  return false;
+}
+
+/// The version and the options, but for those that do not affect the results
+static std::string analysis_configuration(const optionst &options)
+{
+  std::ostringstream configuration;
+  configuration << CBMC_VERSION << '\n';
+  optionst analysis_options = options;
+  analysis_options.set_option("outfile", std::string());
+  analysis_options.set_option("cache-dir", std::string());
+  analysis_options.output(configuration);
+  return configuration.str();
+}
+
+/// A digest of the symbol table and of all function bodies of
+/// \p goto_model, listed by name to be independent of the order of the
+/// strings in the string table
+static std::string model_digest(const goto_modelt &goto_model)
+{
+  std::ostringstream out;
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt irep_serialization(ireps_container);
+
+  std::vector<irep_idt> symbols;
+  for(const auto &symbol : goto_model.symbol_table.symbols)
+    symbols.push_back(symbol.first);
+  std::sort(
+    symbols.begin(), symbols.end(), [](const irep_idt &a, const irep_idt &b) {
+      return id2string(a) < id2string(b);
+    });
+
+  for(const auto &id : symbols)
+  {
+    const symbolt &symbol = goto_model.symbol_table.lookup_ref(id);
+    out << id << '\n';
+    irep_serialization.reference_convert(symbol.type, out);
+    irep_serialization.reference_convert(symbol.value, out);
+
+    const auto f_it = goto_model.goto_functions.function_map.find(id);
+    if(f_it != goto_model.goto_functions.function_map.end())
+      out << function_digest(f_it->second.body);
+    out << '\n';
+  }
+
+  return string_digest(out.str());
+}
+
+bool static_verifier_cached(
+  const goto_modelt &goto_model,
+  ai_baset &ai,
+  const optionst &options,
+  message_handlert &message_handler,
+  std::ostream &out)
+{
+  PRECONDITION(options.is_set("cache-dir"));
+
+  namespacet ns(goto_model.symbol_table);
+  messaget m(message_handler);
+
+  const std::string &cache_dir = options.get_option("cache-dir");
+  const bool write = open_cache_dir(cache_dir, m);
+
+  const std::string key =
+    analysis_configuration(options) + model_digest(goto_model);
+  const std::string file_name =
+    concat_dir_file(cache_dir, string_digest(key) + ".json");
+
+  std::vector<static_verifier_resultt> results;
+  if(!read_cache(file_name, results))
+  {
+    m.status() << "Reused cached results of the analysis" << messaget::eom;
+  }
+  else
+  {
+    results.clear();
+
+    m.status() << "Computing abstract states" << messaget::eom;
+    ai(goto_model);
+    m.statistics() << "Abstract interpretation took " << ai.get_steps()
+                   << " steps" << messaget::eom;
+
+    m.status() << "Checking assertions" << messaget::eom;
+    check_assertions(goto_model, ai, ns, m, results);
+
+    if(write)
+      write_cache(results, file_name, m);
+  }
+
+  static_verifier_report(results, ns, options, m, out);
+
+  return false;
+}
+
+bool static_verifier_modular(
+  const goto_modelt &goto_model,
+  ai_baset &ai,
+  const optionst &options,
+  message_handlert &message_handler,
+  std::ostream &out)
+{
+  namespacet ns(goto_model.symbol_table);
+  messaget m(message_handler);
+
+  const bool use_cache = options.is_set("cache-dir");
+  const std::string &cache_dir = options.get_option("cache-dir");
+  const bool write = use_cache && open_cache_dir(cache_dir, m);
+  const std::string configuration =
+    use_cache ? analysis_configuration(options) : std::string();
+
+  std::unordered_map<irep_idt, std::string> function_digests;
+  if(use_cache)
+  {
+    for(const auto &f : goto_model.goto_functions.function_map)
+      function_digests[f.first] = function_digest(f.second.body);
+  }
+
+  const call_grapht::directed_grapht call_graph =
+    call_grapht(goto_model).get_directed_graph();
+
+  m.status() << "Checking assertions" << messaget::eom;
+
+  std::vector<static_verifier_resultt> results;
+  std::size_t reused = 0, analysed = 0, steps = 0;
+
+  for(const auto &f : goto_model.goto_functions.function_map)
+  {
+    if(!f.second.body.has_assertion())
+      continue;
+
+    std::vector<static_verifier_resultt> function_results;
+    std::string file_name;
+
+    if(use_cache)
+    {
+      // The results of a function depend on its body and on those of all
+      // functions it may call, listed by name to be independent of the order
+      // of the strings in the string table
+      std::vector<std::string> callees;
+      for(const irep_idt &callee : get_reachable_functions(call_graph, f.first))
+        callees.push_back(id2string(callee));
+      std::sort(callees.begin(), callees.end());
+
+      std::string key = configuration + id2string(f.first) + '\n';
+      for(const auto &callee : callees)
+        key += callee + ' ' + function_digests.at(callee) + '\n';
+
+      file_name = concat_dir_file(cache_dir, string_digest(key) + ".json");
+
+      if(!read_cache(file_name, function_results))
+      {
+        ++reused;
+        results.insert(
+          results.end(), function_results.begin(), function_results.end());
+        continue;
+      }
+    }
+
+    m.progress() << "Analysing " << ns.lookup(f.first).display_name()
+                 << messaget::eom;
+
+    ai.clear();
+    ai(f.first, goto_model.goto_functions, ns);
+    steps += ai.get_steps();
+    ++analysed;
+
+    function_results.clear();
+    check_assertions(ai, f.first, f.second.body, ns, function_results);
+
+    if(write)
+      write_cache(function_results, file_name, m);
+
+    results.insert(
+      results.end(), function_results.begin(), function_results.end());
+  }
+
+  if(use_cache)
+  {
+    m.status() << "Reused cached results for " << reused << " of "
+               << reused + analysed << " functions" << messaget::eom;
+  }
+  m.statistics() << "Abstract interpretation took " << steps << " steps"
+                 << messaget::eom;
+
+  static_verifier_report(results, ns, options, m, out);
 
   return false;
 }
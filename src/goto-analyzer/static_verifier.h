@@ -25,6 +25,32 @@ bool static_verifier(
   message_handlert &,
   std::ostream &);
 
+/// Check the assertions like \ref static_verifier, running \p ai on the
+/// whole program first. The results are stored in the directory given by the
+/// option "cache-dir", keyed by the program and the options, and reused as
+/// long as neither of these has changed.
+/// \return false on success with the results printed to the stream
+bool static_verifier_cached(
+  const goto_modelt &,
+  ai_baset &,
+  const optionst &,
+  message_handlert &,
+  std::ostream &);
+
+/// Check the assertions of each function on its own, analysing it and the
+/// functions it calls with \p ai from the entry of the function, so that the
+/// results do not depend on its callers. With the option "cache-dir", the
+/// results are stored in that directory, keyed by the body of the function
+/// and those of its callees, and reused for the functions for which none of
+/// these has changed.
+/// \return false on success with the results printed to the stream
+bool static_verifier_modular(
+  const goto_modelt &,
+  ai_baset &,
+  const optionst &,
+  message_handlert &,
+  std::ostream &);
+
 /// Use the information from the abstract interpreter to fill out the statuses
 /// of the passed properties
 /// \param abstract_goto_model The goto program to verify
@@ -11,8 +11,17 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "taint_analysis.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <list>
+#include <vector>
+
+#ifdef CPROVER_THREAD_SAFE
+#include <atomic>
+#include <exception>
+#include <thread>
+#endif
 
 #include <util/invariant.h>
 #include <util/json.h>
@@ -35,33 +44,85 @@ public:
   }
 
   bool operator()(
-    const std::string &taint_file_name,
+    const std::list<std::string> &taint_file_names,
     const symbol_tablet &,
     goto_functionst &,
     bool show_full,
-    const optionalt<std::string> &json_file_name);
+    const optionalt<std::string> &json_file_name,
+    std::size_t number_of_threads);
 
 protected:
   messaget log;
-  taint_parse_treet taint;
   class_hierarchyt class_hierarchy;
 
-  void instrument(const namespacet &, goto_functionst &);
-  void instrument(const namespacet &, goto_functionst::goto_functiont &);
+  /// The rules of one taint specification file
+  struct rule_sett
+  {
+    std::string file_name;
+    taint_parse_treet taint;
+    /// Distinguishes the taint names of this rule set from those of other
+    /// rule sets that are analysed in the same pass
+    std::string prefix;
+  };
+
+  std::vector<rule_sett> rule_sets;
+
+  /// Rule sets (indices into rule_sets) that are analysed together, each
+  /// with its own range of bits
+  typedef std::vector<std::size_t> passt;
+
+  struct violationt
+  {
+    irep_idt function_id;
+    source_locationt source_location;
+  };
+
+  bool read_rule_sets(const std::list<std::string> &taint_file_names);
+  std::vector<passt> group_into_passes() const;
+
+  void instrument(const namespacet &, std::size_t, goto_functionst &);
+  void instrument(
+    const namespacet &,
+    std::size_t,
+    goto_functionst::goto_functiont &);
+
+  /// Add an entry point that calls all functions with a body
+  void add_entry_point(const namespacet &, goto_functionst &);
+
+  void analyse_pass(
+    const passt &,
+    const namespacet &,
+    goto_functionst &,
+    custom_bitvector_analysist &);
+
+  void collect_violations(
+    const namespacet &,
+    const goto_functionst &,
+    custom_bitvector_analysist &,
+    std::vector<std::vector<violationt>> &);
 };
 
+/// Irep attribute of the source location of a sink assertion that stores the
+/// index of the rule set it was generated from
+static const char taint_rule_set_attribute[] = "taint_rule_set";
+
 void taint_analysist::instrument(
   const namespacet &ns,
+  std::size_t rule_set,
   goto_functionst &goto_functions)
 {
   for(auto &function : goto_functions.function_map)
-    instrument(ns, function.second);
+    instrument(ns, rule_set, function.second);
 }
 
 void taint_analysist::instrument(
   const namespacet &ns,
+  std::size_t rule_set,
   goto_functionst::goto_functiont &goto_function)
 {
+  const taint_parse_treet &taint = rule_sets[rule_set].taint;
+  const std::string &prefix = rule_sets[rule_set].prefix;
+
   for(goto_programt::instructionst::iterator
       it=goto_function.body.instructions.begin();
       it!=goto_function.body.instructions.end();
@@ -122,6 +183,7 @@ void taint_analysist::instrument(
                         << messaget::eom;
 
             exprt where = nil_exprt();
+            const irep_idt taint_name = prefix + id2string(rule.taint);
 
             const code_typet &code_type = to_code_type(function.type());
 
@@ -166,7 +228,7 @@ void taint_analysist::instrument(
               code_set_may.operands().resize(2);
               code_set_may.op0() = where;
               code_set_may.op1() =
-                address_of_exprt(string_constantt(rule.taint));
+                address_of_exprt(string_constantt(taint_name));
               insert_after.add(goto_programt::make_other(
                 code_set_may, instruction.source_location));
               break;
@@ -177,13 +239,14 @@ void taint_analysist::instrument(
               binary_predicate_exprt get_may{
                 where,
                 ID_get_may,
-                address_of_exprt(string_constantt(rule.taint))};
+                address_of_exprt(string_constantt(taint_name))};
               goto_programt::targett t =
                 insert_before.add(goto_programt::make_assertion(
                   not_exprt(get_may), instruction.source_location));
               t->source_location.set_property_class(
                 "taint rule " + id2string(rule.id));
               t->source_location.set_comment(rule.message);
+              t->source_location.set(taint_rule_set_attribute, rule_set);
               break;
             }
 
@@ -193,7 +256,7 @@ void taint_analysist::instrument(
               code_clear_may.operands().resize(2);
               code_clear_may.op0() = where;
               code_clear_may.op1() =
-                address_of_exprt(string_constantt(rule.taint));
+                address_of_exprt(string_constantt(taint_name));
               insert_after.add(goto_programt::make_other(
                 code_clear_may, instruction.source_location));
               break;
@@ -219,42 +282,194 @@ void taint_analysist::instrument(
   }
 }
 
-bool taint_analysist::operator()(
-  const std::string &taint_file_name,
-  const symbol_tablet &symbol_table,
-  goto_functionst &goto_functions,
-  bool show_full,
-  const optionalt<std::string> &json_file_name)
+bool taint_analysist::read_rule_sets(
+  const std::list<std::string> &taint_file_names)
 {
-  try
+  for(const auto &taint_file_name : taint_file_names)
   {
-    json_arrayt json_result;
-    bool use_json = json_file_name.has_value();
+    rule_sets.emplace_back();
+    rule_sett &rule_set = rule_sets.back();
+    rule_set.file_name = taint_file_name;
 
     log.status() << "Reading taint file '" << taint_file_name << "'"
                  << messaget::eom;
 
-    if(taint_parser(taint_file_name, taint, log.get_message_handler()))
+    if(taint_parser(taint_file_name, rule_set.taint, log.get_message_handler()))
     {
       log.error() << "Failed to read taint definition file" << messaget::eom;
       return true;
     }
 
-    log.status() << "Got " << taint.rules.size() << " taint definitions"
-                 << messaget::eom;
+    log.status() << "Got " << rule_set.taint.rules.size()
+                 << " taint definitions" << messaget::eom;
+
+    log.conditional_output(
+      log.debug(), [&rule_set](messaget::mstreamt &mstream) {
+        rule_set.taint.output(mstream);
+        mstream << messaget::eom;
+      });
+  }
 
-    log.conditional_output(log.debug(), [this](messaget::mstreamt &mstream) {
-      taint.output(mstream);
-      mstream << messaget::eom;
-    });
+  // Rule sets may use the same taint names for different purposes
+  if(rule_sets.size() > 1)
+  {
+    for(std::size_t i = 0; i < rule_sets.size(); ++i)
+      rule_sets[i].prefix = std::to_string(i) + "::";
+  }
+
+  return false;
+}
+
+std::vector<taint_analysist::passt> taint_analysist::group_into_passes() const
+{
+  // One bit is kept for taint names that cannot be determined statically
+  const std::size_t max_bits =
+    sizeof(custom_bitvector_domaint::bit_vectort) * 8 - 1;
+
+  std::vector<passt> passes;
+  std::size_t bits_used = 0;
+
+  for(std::size_t i = 0; i < rule_sets.size(); ++i)
+  {
+    std::set<irep_idt> taint_names;
+    for(const auto &rule : rule_sets[i].taint.rules)
+      taint_names.insert(rule.taint);
+
+    if(taint_names.size() > max_bits)
+    {
+      throw "taint file '" + rule_sets[i].file_name + "' uses more than " +
+        std::to_string(max_bits) + " different taints";
+    }
+
+    if(passes.empty() || bits_used + taint_names.size() > max_bits)
+    {
+      passes.emplace_back();
+      bits_used = 0;
+    }
+
+    passes.back().push_back(i);
+    bits_used += taint_names.size();
+  }
+
+  return passes;
+}
+
+void taint_analysist::analyse_pass(
+  const passt &pass,
+  const namespacet &ns,
+  goto_functionst &goto_functions,
+  custom_bitvector_analysist &custom_bitvector_analysis)
+{
+  for(const auto rule_set : pass)
+  {
+    // give the taints of each rule set a consecutive range of bits
+    for(const auto &rule : rule_sets[rule_set].taint.rules)
+    {
+      custom_bitvector_analysis.bits.number(
+        rule_sets[rule_set].prefix + id2string(rule.taint));
+    }
+  }
+
+  custom_bitvector_analysis(goto_functions, ns);
+}
+
+void taint_analysist::collect_violations(
+  const namespacet &ns,
+  const goto_functionst &goto_functions,
+  custom_bitvector_analysist &custom_bitvector_analysis,
+  std::vector<std::vector<violationt>> &violations)
+{
+  forall_goto_functions(f_it, goto_functions)
+  {
+    if(!f_it->second.body.has_assertion())
+      continue;
+
+    if(f_it->first=="__actual_thread_spawn")
+      continue;
+
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      if(!i_it->is_assert())
+        continue;
+
+      if(!custom_bitvector_domaint::has_get_must_or_may(
+           i_it->get_condition()))
+      {
+        continue;
+      }
+
+      if(custom_bitvector_analysis[i_it].has_values.is_false())
+        continue;
+
+      exprt result =
+        custom_bitvector_analysis.eval(i_it->get_condition(), i_it);
+      if(simplify_expr(std::move(result), ns).is_true())
+        continue;
+
+      const std::size_t rule_set =
+        i_it->source_location.get_size_t(taint_rule_set_attribute);
+      violations.at(rule_set).push_back({f_it->first, i_it->source_location});
+    }
+  }
+}
+
+void taint_analysist::add_entry_point(
+  const namespacet &ns,
+  goto_functionst &goto_functions)
+{
+  goto_programt end, gotos, calls;
+
+  end.add(goto_programt::make_end_function());
+
+  forall_goto_functions(f_it, goto_functions)
+    if(f_it->second.body_available() &&
+       f_it->first!=goto_functionst::entry_point())
+    {
+      const symbolt &symbol = ns.lookup(f_it->first);
+      const code_function_callt call(symbol.symbol_expr());
+      goto_programt::targett t =
+        calls.add(goto_programt::make_function_call(call));
+      calls.add(
+        goto_programt::make_goto(end.instructions.begin(), true_exprt()));
+      gotos.add(goto_programt::make_goto(
+        t, side_effect_expr_nondett(bool_typet(), symbol.location)));
+    }
+
+  goto_functionst::goto_functiont &entry=
+    goto_functions.function_map[goto_functionst::entry_point()];
+
+  goto_programt &body=entry.body;
+
+  body.destructive_append(gotos);
+  body.destructive_append(calls);
+  body.destructive_append(end);
+}
+
+bool taint_analysist::operator()(
+  const std::list<std::string> &taint_file_names,
+  const symbol_tablet &symbol_table,
+  goto_functionst &goto_functions,
+  bool show_full,
+  const optionalt<std::string> &json_file_name,
+  std::size_t number_of_threads)
+{
+  PRECONDITION(number_of_threads > 0);
+
+  try
+  {
+    json_arrayt json_result;
+    bool use_json = json_file_name.has_value();
+
+    if(read_rule_sets(taint_file_names))
+      return true;
+
+    const std::vector<passt> passes = group_into_passes();
 
     log.status() << "Instrumenting taint" << messaget::eom;
 
     class_hierarchy(symbol_table);
 
     const namespacet ns(symbol_table);
-    instrument(ns, goto_functions);
-    goto_functions.update();
 
     bool have_entry_point=
       goto_functions.function_map.find(goto_functionst::entry_point())!=
@@ -270,106 +485,150 @@ bool taint_analysist::operator()(
       log.status() << "No entry point found; "
                    << "we will consider the heads of all functions as reachable"
                    << messaget::eom;
+    }
 
-      goto_programt end, gotos, calls;
-
-      end.add(goto_programt::make_end_function());
-
-      forall_goto_functions(f_it, goto_functions)
-        if(f_it->second.body_available() &&
-           f_it->first!=goto_functionst::entry_point())
-        {
-          const symbolt &symbol = ns.lookup(f_it->first);
-          const code_function_callt call(symbol.symbol_expr());
-          goto_programt::targett t =
-            calls.add(goto_programt::make_function_call(call));
-          calls.add(
-            goto_programt::make_goto(end.instructions.begin(), true_exprt()));
-          gotos.add(goto_programt::make_goto(
-            t, side_effect_expr_nondett(bool_typet(), symbol.location)));
-        }
-
-      goto_functionst::goto_functiont &entry=
-        goto_functions.function_map[goto_functionst::entry_point()];
+    // Each pass analyses an instrumented copy of the program, unless there
+    // is only one pass
+    std::vector<goto_functionst> pass_functions(passes.size());
+    for(std::size_t p = 0; p < passes.size(); ++p)
+    {
+      goto_functionst &functions =
+        passes.size() == 1 ? goto_functions : pass_functions[p];
+      if(passes.size() > 1)
+        functions.copy_from(goto_functions);
 
-      goto_programt &body=entry.body;
+      for(const auto rule_set : passes[p])
+        instrument(ns, rule_set, functions);
 
-      body.destructive_append(gotos);
-      body.destructive_append(calls);
-      body.destructive_append(end);
+      // the calls of the entry point are not to be instrumented, as they do
+      // not pass any arguments
+      if(!have_entry_point)
+        add_entry_point(ns, functions);
 
-      goto_functions.update();
+      functions.update();
     }
 
     log.status() << "Data-flow analysis" << messaget::eom;
 
-    custom_bitvector_analysist custom_bitvector_analysis;
-    custom_bitvector_analysis(goto_functions, ns);
-
-    if(show_full)
+    if(passes.size() > 1)
     {
-      custom_bitvector_analysis.output(ns, goto_functions, std::cout);
-      return false;
+      log.status() << "Checking " << rule_sets.size() << " rule sets in "
+                   << passes.size() << " passes" << messaget::eom;
     }
 
-    forall_goto_functions(f_it, goto_functions)
-    {
-      if(!f_it->second.body.has_assertion())
-        continue;
+    std::vector<std::vector<violationt>> violations(rule_sets.size());
 
-      const symbolt &symbol=ns.lookup(f_it->first);
+    auto run_pass = [&](std::size_t p) {
+      goto_functionst &functions =
+        passes.size() == 1 ? goto_functions : pass_functions[p];
 
-      if(f_it->first=="__actual_thread_spawn")
-        continue;
+      custom_bitvector_analysist custom_bitvector_analysis;
+      analyse_pass(passes[p], ns, functions, custom_bitvector_analysis);
+
+      if(show_full)
+        custom_bitvector_analysis.output(ns, functions, std::cout);
+      else
+      {
+        collect_violations(
+          ns, functions, custom_bitvector_analysis, violations);
+      }
 
-      bool first=true;
+      // release the copy once its results have been collected
+      if(passes.size() > 1)
+        functions.clear();
+    };
 
-      forall_goto_program_instructions(i_it, f_it->second.body)
+#ifdef CPROVER_THREAD_SAFE
+    // Passes share no state other than the symbol table, and each writes the
+    // violations of its own rule sets only
+    if(!show_full && number_of_threads > 1 && passes.size() > 1)
+    {
+      std::atomic<std::size_t> next(0);
+      std::vector<std::exception_ptr> exceptions(
+        std::min(number_of_threads, passes.size()));
+      std::vector<std::thread> threads;
+
+      for(auto &exception : exceptions)
       {
-        if(!i_it->is_assert())
-          continue;
+        threads.emplace_back([&] {
+          try
+          {
+            for(std::size_t p = next++; p < passes.size(); p = next++)
+              run_pass(p);
+          }
+          catch(...)
+          {
+            exception = std::current_exception();
+          }
+        });
+      }
 
-        if(!custom_bitvector_domaint::has_get_must_or_may(
-             i_it->get_condition()))
-        {
-          continue;
-        }
+      for(auto &thread : threads)
+        thread.join();
+
+      for(const auto &exception : exceptions)
+      {
+        if(exception != nullptr)
+          std::rethrow_exception(exception);
+      }
+    }
+    else
+#endif
+    {
+      for(std::size_t p = 0; p < passes.size(); ++p)
+        run_pass(p);
+    }
+
+    if(show_full)
+      return false;
+
+    for(std::size_t rule_set = 0; rule_set < rule_sets.size(); ++rule_set)
+    {
+      const std::string &file_name = rule_sets[rule_set].file_name;
+
+      if(rule_sets.size() > 1 && !use_json)
+      {
+        std::cout << "\n"
+                  << "======== Rule set " << file_name << ": "
+                  << violations[rule_set].size() << " violation"
+                  << (violations[rule_set].size() == 1 ? "" : "s") << '\n';
+      }
 
-        if(custom_bitvector_analysis[i_it].has_values.is_false())
-          continue;
+      irep_idt current_function;
 
-        exprt result =
-          custom_bitvector_analysis.eval(i_it->get_condition(), i_it);
-        if(simplify_expr(std::move(result), ns).is_true())
-          continue;
+      for(const auto &violation : violations[rule_set])
+      {
+        const source_locationt &source_location = violation.source_location;
 
-        if(first)
+        if(violation.function_id != current_function)
         {
-          first=false;
+          current_function = violation.function_id;
           if(!use_json)
+          {
+            const symbolt &symbol = ns.lookup(current_function);
             std::cout << "\n"
                       << "******** Function " << symbol.display_name() << '\n';
+          }
         }
 
         if(use_json)
         {
           json_objectt json{
-            {"bugClass",
-             json_stringt(i_it->source_location.get_property_class())},
-            {"file", json_stringt(i_it->source_location.get_file())},
-            {"line",
-             json_numbert(id2string(i_it->source_location.get_line()))}};
+            {"bugClass", json_stringt(source_location.get_property_class())},
+            {"file", json_stringt(source_location.get_file())},
+            {"line", json_numbert(id2string(source_location.get_line()))}};
+          if(rule_sets.size() > 1)
+            json["ruleSet"] = json_stringt(file_name);
           json_result.push_back(std::move(json));
         }
         else
         {
-          std::cout << i_it->source_location;
-          if(!i_it->source_location.get_comment().empty())
-            std::cout << ": " << i_it->source_location.get_comment();
+          std::cout << source_location;
+          if(!source_location.get_comment().empty())
+            std::cout << ": " << source_location.get_comment();
 
-          if(!i_it->source_location.get_property_class().empty())
-            std::cout << " ("
-                      << i_it->source_location.get_property_class() << ")";
+          if(!source_location.get_property_class().empty())
+            std::cout << " (" << source_location.get_property_class() << ")";
 
           std::cout << '\n';
         }
@@ -419,12 +678,30 @@ bool taint_analysis(
   message_handlert &message_handler,
   bool show_full,
   const optionalt<std::string> &json_file_name)
+{
+  return taint_analysis(
+    goto_model,
+    {taint_file_name},
+    message_handler,
+    show_full,
+    json_file_name,
+    1);
+}
+
+bool taint_analysis(
+  goto_modelt &goto_model,
+  const std::list<std::string> &taint_file_names,
+  message_handlert &message_handler,
+  bool show_full,
+  const optionalt<std::string> &json_file_name,
+  std::size_t number_of_threads)
 {
   taint_analysist taint_analysis(message_handler);
   return taint_analysis(
-    taint_file_name,
+    taint_file_names,
     goto_model.symbol_table,
     goto_model.goto_functions,
     show_full,
-    json_file_name);
+    json_file_name,
+    number_of_threads);
 }
@@ -12,6 +12,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_ANALYZER_TAINT_ANALYSIS_H
 #define CPROVER_GOTO_ANALYZER_TAINT_ANALYSIS_H
 
+#include <list>
+#include <string>
+
 #include <util/message.h>
 #include <util/namespace.h>
 
@@ -24,4 +27,17 @@ bool taint_analysis(
   bool show_full,
   const optionalt<std::string> &json_output_file_name = {});
 
+/// Check several taint specifications against the same program. The rule
+/// sets are grouped into as few data-flow passes as possible, where each
+/// rule set gets its own range of bits in the bit vectors of the analysis.
+/// Passes are independent and run on \p number_of_threads threads when
+/// built with CPROVER_THREAD_SAFE. Violations are reported per rule set.
+bool taint_analysis(
+  goto_modelt &,
+  const std::list<std::string> &taint_file_names,
+  message_handlert &,
+  bool show_full,
+  const optionalt<std::string> &json_output_file_name,
+  std::size_t number_of_threads);
+
 #endif // CPROVER_GOTO_ANALYZER_TAINT_ANALYSIS_H
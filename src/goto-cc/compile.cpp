@@ -16,9 +16,20 @@ Date: June 2006
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 #include <util/cmdline.h>
 #include <util/config.h>
+#include <util/exception_utils.h>
 #include <util/file_util.h>
 #include <util/get_base_name.h>
 #include <util/prefix.h>
@@ -357,6 +368,11 @@ bool compilet::link()
 /// \return true on error, false otherwise
 bool compilet::compile()
 {
+#ifndef _WIN32
+  if(jobs > 1 && source_files.size() > 1)
+    return compile_in_parallel();
+#endif
+
   while(!source_files.empty())
   {
     std::string file_name=source_files.front();
@@ -367,85 +383,358 @@ bool compilet::compile()
     if(echo_file_name)
       std::cout << get_base_name(file_name, false) << '\n' << std::flush;
 
-    bool r=parse_source(file_name); // don't break the program!
+    const std::string object_file =
+      mode == COMPILE_ONLY || mode == ASSEMBLE_ONLY
+        ? object_file_name(file_name)
+        : std::string();
 
-    if(r)
+    if(compile_source_file(file_name, object_file))
+      return true;
+
+    if(!object_file.empty())
+    {
+      if(add_written_cprover_symbols(goto_model.symbol_table))
+        return true;
+
+      goto_model.clear(); // clean symbol table for next source file.
+    }
+  }
+
+  return false;
+}
+
+/// \return the name of the object file for \p file_name when compiling only
+std::string compilet::object_file_name(const std::string &file_name) const
+{
+  if(!output_file_object.empty())
+    return output_file_object;
+
+  const std::string file_name_with_obj_ext =
+    get_base_name(file_name, true) + "." + object_file_extension;
+
+  if(!output_directory_object.empty())
+    return concat_dir_file(output_directory_object, file_name_with_obj_ext);
+  else
+    return file_name_with_obj_ext;
+}
+
+/// Parse and type check \p file_name. If \p object_file is not empty, the
+/// functions of the file are converted and written to \p object_file,
+/// otherwise the symbols are kept in the symbol table for linking.
+/// \return true on error, false otherwise
+bool compilet::compile_source_file(
+  const std::string &file_name,
+  const std::string &object_file)
+{
+  // the object file of an earlier compilation of the same source?
+  std::string key;
+  optionalt<std::string> preprocessed;
+  bool r = false;
+
+  if(!object_file.empty() && cache.enabled())
+  {
+    std::string preprocessed_source;
+    r = cache_key(file_name, key, preprocessed_source);
+
+    const std::string cached =
+      key.empty() ? std::string() : cache.lookup(key);
+
+    if(!cached.empty())
     {
-      const std::string &debug_outfile=
-        cmdline.get_value("print-rejected-preprocessed-source");
-      if(!debug_outfile.empty())
+      auto cached_model = read_goto_binary(cached, get_message_handler());
+      if(cached_model.has_value())
       {
-        std::ifstream in(file_name, std::ios::binary);
-        std::ofstream out(debug_outfile, std::ios::binary);
-        out << in.rdbuf();
-        warning() << "Failed sources in " << debug_outfile << eom;
+        goto_model.symbol_table.swap(cached_model->symbol_table);
+        goto_model.goto_functions.swap(cached_model->goto_functions);
+        return write_bin_object_file(object_file, goto_model);
       }
+    }
+
+    // on a miss, parse what was preprocessed for the key
+    if(!key.empty())
+      preprocessed = std::move(preprocessed_source);
+  }
+
+  if(r)
+    error() << "PARSING ERROR" << eom;
+  else
+    r = parse_source(file_name, preprocessed); // don't break the program!
 
-      return true; // parser/typecheck error
+  if(r)
+  {
+    const std::string &debug_outfile=
+      cmdline.get_value("print-rejected-preprocessed-source");
+    if(!debug_outfile.empty())
+    {
+      std::ifstream in(file_name, std::ios::binary);
+      std::ofstream out(debug_outfile, std::ios::binary);
+      out << in.rdbuf();
+      warning() << "Failed sources in " << debug_outfile << eom;
     }
 
-    if(mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY)
+    return true; // parser/typecheck error
+  }
+
+  if(object_file.empty())
+    return false;
+
+  // "compile" functions
+  convert_symbols(goto_model.goto_functions);
+
+  if(keep_file_local && (mode == COMPILE_ONLY || mode == ASSEMBLE_ONLY))
+  {
+    function_name_manglert<file_name_manglert> mangler(
+      get_message_handler(), goto_model, file_local_mangle_suffix);
+    mangler.mangle();
+  }
+
+  if(write_bin_object_file(object_file, goto_model))
+    return true;
+
+  if(!key.empty())
+    cache.store(key, object_file);
+
+  return false;
+}
+
+#ifndef _WIN32
+/// Compile the source files in up to \ref jobs child processes at a time.
+/// The parsers are global state, hence processes rather than threads. Each
+/// child writes an object file; when linking, these are temporary files that
+/// are linked in the order of the source files, before any other object
+/// files, so the result does not depend on which child finishes first.
+/// \return true on error, false otherwise
+bool compilet::compile_in_parallel()
+{
+  const bool compile_only = mode == COMPILE_ONLY || mode == ASSEMBLE_ONLY;
+
+  std::string tmp_dir;
+  if(!compile_only)
+  {
+    tmp_dir = get_temporary_directory("goto-cc.XXXXXX");
+    tmp_dirs.push_back(tmp_dir);
+  }
+
+  std::vector<std::pair<std::string, std::string>> units;
+  for(const auto &file_name : source_files)
+  {
+    units.emplace_back(
+      file_name,
+      compile_only ? object_file_name(file_name)
+                   : concat_dir_file(
+                       tmp_dir, std::to_string(units.size()) + ".gb"));
+  }
+  source_files.clear();
+
+  std::map<pid_t, std::string> running;
+  std::size_t next = 0;
+  bool failed = false;
+
+  while(!running.empty() || (!failed && next < units.size()))
+  {
+    if(!failed && next < units.size() && running.size() < jobs)
     {
-      // output an object file for every source file
+      const auto &unit = units[next++];
 
-      // "compile" functions
-      convert_symbols(goto_model.goto_functions);
+      if(echo_file_name)
+        std::cout << get_base_name(unit.first, false) << '\n';
 
-      std::string cfn;
+      // don't let the child repeat buffered output
+      std::cout << std::flush;
+      std::cerr << std::flush;
 
-      if(output_file_object.empty())
-      {
-        const std::string file_name_with_obj_ext =
-          get_base_name(file_name, true) + "." + object_file_extension;
+      const pid_t pid = fork();
 
-        if(!output_directory_object.empty())
-          cfn = concat_dir_file(output_directory_object, file_name_with_obj_ext);
-        else
-          cfn = file_name_with_obj_ext;
+      if(pid == 0)
+      {
+        // Exceptions must not leave this block: unwinding would run the
+        // destructors, and the parent owns the temporary directories
+        bool r = true;
+        try
+        {
+          r = compile_source_file(unit.first, unit.second);
+        }
+        catch(const cprover_exception_baset &e)
+        {
+          error() << e.what() << eom;
+        }
+        catch(...)
+        {
+          error() << "compilation of '" << unit.first << "' failed" << eom;
+        }
+        std::cout << std::flush;
+        std::cerr << std::flush;
+        _exit(r ? 1 : 0);
       }
-      else
-        cfn = output_file_object;
-
-      if(keep_file_local)
+      else if(pid == -1)
       {
-        function_name_manglert<file_name_manglert> mangler(
-          get_message_handler(), goto_model, file_local_mangle_suffix);
-        mangler.mangle();
+        error() << "failed to start process for '" << unit.first << "'"
+                << eom;
+        failed = true;
       }
+      else
+        running[pid] = unit.first;
 
-      if(write_bin_object_file(cfn, goto_model))
-        return true;
+      continue;
+    }
 
-      if(add_written_cprover_symbols(goto_model.symbol_table))
-        return true;
+    int status;
+    const pid_t pid = waitpid(-1, &status, 0);
 
-      goto_model.clear(); // clean symbol table for next source file.
+    if(pid == -1)
+    {
+      if(errno == EINTR)
+        continue;
+
+      error() << "failed to wait for compilation processes" << eom;
+      return true;
     }
+
+    const auto unit = running.find(pid);
+    if(unit == running.end())
+      continue;
+
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+      if(!WIFEXITED(status))
+        error() << "compilation of '" << unit->second << "' terminated"
+                << eom;
+      failed = true;
+    }
+
+    running.erase(unit);
+  }
+
+  if(failed)
+    return true;
+
+  if(!compile_only)
+  {
+    // link the sources first, as in sequential compilation
+    auto position = object_files.begin();
+    for(const auto &unit : units)
+      object_files.insert(position, unit.second);
+
+    return false;
   }
 
+  // the children's object files are read back to check and record the
+  // __CPROVER macros they define, in the order of the source files
+  for(const auto &unit : units)
+  {
+    auto object = read_goto_binary(unit.second, get_message_handler());
+    if(!object.has_value())
+      return true;
+
+    if(add_written_cprover_symbols(object->symbol_table))
+      return true;
+  }
+
+  wrote_object = true;
+
   return false;
 }
+#endif
 
-/// parses a source file (low-level parsing)
-/// \return true on error, false otherwise
-bool compilet::parse(
-  const std::string &file_name,
-  language_filest &language_files)
+/// \return the language of \p file_name, or nullptr if not known
+std::unique_ptr<languaget>
+compilet::get_language(const std::string &file_name) const
 {
-  std::unique_ptr<languaget> languagep;
-
   // Using '-x', the type of a file can be overridden;
   // otherwise, it's guessed from the extension.
 
   if(!override_language.empty())
   {
     if(override_language=="c++" || override_language=="c++-header")
-      languagep = get_language_from_mode(ID_cpp);
+      return get_language_from_mode(ID_cpp);
     else
-      languagep = get_language_from_mode(ID_C);
+      return get_language_from_mode(ID_C);
   }
   else if(file_name != "-")
-    languagep=get_language_from_filename(file_name);
+    return get_language_from_filename(file_name);
+
+  return nullptr;
+}
+
+/// Preprocess \p file_name to obtain the key under which its object file is
+/// cached: the preprocessed source together with everything else the object
+/// file depends on
+/// \param file_name: the source file
+/// \param [out] key: the key, or the empty string if \p file_name can't be
+///   cached
+/// \param [out] preprocessed: the preprocessed source
+/// \return true if preprocessing failed, false otherwise
+bool compilet::cache_key(
+  const std::string &file_name,
+  std::string &key,
+  std::string &preprocessed)
+{
+  key.clear();
+
+  std::unique_ptr<languaget> language = get_language(file_name);
+  if(language == nullptr || (language->id() != "C" && language->id() != "cpp"))
+    return false;
+
+  // the source isn't preprocessed again when compiling it, hence this reports
+  // the warnings and errors
+  language->set_message_handler(get_message_handler());
+
+#ifdef _MSC_VER
+  std::ifstream infile(widen(file_name));
+#else
+  std::ifstream infile(file_name);
+#endif
+
+  if(!infile)
+    return false;
+
+  std::ostringstream preprocessed_stream;
+  if(language->preprocess(infile, file_name, preprocessed_stream))
+    return true;
+  preprocessed = preprocessed_stream.str();
+
+  const configt::ansi_ct &ansi_c = config.ansi_c;
+
+  std::ostringstream header;
+  header << CBMC_VERSION << '\n'
+         << file_name << ' ' << language->id() << ' ' << keep_file_local << ' '
+         << file_local_mangle_suffix << '\n'
+         << ansi_c.arch << ' '
+         << configt::ansi_ct::os_to_string(ansi_c.os) << ' '
+         << static_cast<int>(ansi_c.endianness) << ' '
+         << static_cast<int>(ansi_c.mode) << ' '
+         << static_cast<int>(ansi_c.c_standard) << ' '
+         << static_cast<int>(config.cpp.cpp_standard) << '\n'
+         << ansi_c.int_width << ' ' << ansi_c.long_int_width << ' '
+         << ansi_c.bool_width << ' ' << ansi_c.char_width << ' '
+         << ansi_c.short_int_width << ' ' << ansi_c.long_long_int_width << ' '
+         << ansi_c.pointer_width << ' ' << ansi_c.single_width << ' '
+         << ansi_c.double_width << ' ' << ansi_c.long_double_width << ' '
+         << ansi_c.wchar_t_width << '\n'
+         << ansi_c.char_is_unsigned << ansi_c.wchar_t_is_unsigned
+         << ansi_c.for_has_scope << ansi_c.ts_18661_3_Floatn_types
+         << ansi_c.gcc__float128_type << ansi_c.single_precision_constant
+         << ansi_c.NULL_is_zero << ansi_c.string_abstraction << ' '
+         << static_cast<int>(ansi_c.rounding_mode) << ' ' << ansi_c.alignment
+         << ' ' << ansi_c.memory_operand_size << ' '
+         << config.bv_encoding.object_bits << '\n';
+
+  key = header.str() + preprocessed;
+  return false;
+}
+
+/// parses a source file (low-level parsing)
+/// \param file_name: the source file
+/// \param language_files: the language files to add the source file to
+/// \param preprocessed: the preprocessed source file, if it has been
+///   preprocessed before
+/// \return true on error, false otherwise
+bool compilet::parse(
+  const std::string &file_name,
+  language_filest &language_files,
+  const optionalt<std::string> &preprocessed)
+{
+  std::unique_ptr<languaget> languagep = get_language(file_name);
 
   if(languagep==nullptr)
   {
@@ -499,7 +788,16 @@ bool compilet::parse(
   {
     statistics() << "Parsing: " << file_name << eom;
 
-    if(lf.language->parse(infile, file_name))
+    bool r;
+    if(preprocessed.has_value())
+    {
+      std::istringstream preprocessed_stream(*preprocessed);
+      r = lf.language->parse_preprocessed(preprocessed_stream, file_name);
+    }
+    else
+      r = lf.language->parse(infile, file_name);
+
+    if(r)
     {
       error() << "PARSING ERROR" << eom;
       return true;
@@ -578,7 +876,8 @@ bool compilet::write_bin_object_file(
     return true;
   }
 
-  if(write_goto_binary(outfile, src_goto_model))
+  if(write_goto_binary(
+       outfile, src_goto_model, GOTO_BINARY_VERSION, compress_goto_binary))
     return true;
 
   const auto cnt = function_body_count(src_goto_model.goto_functions);
@@ -594,13 +893,18 @@ bool compilet::write_bin_object_file(
 }
 
 /// parses a source file
+/// \param file_name: the source file
+/// \param preprocessed: the preprocessed source file, if it has been
+///   preprocessed before
 /// \return true on error, false otherwise
-bool compilet::parse_source(const std::string &file_name)
+bool compilet::parse_source(
+  const std::string &file_name,
+  const optionalt<std::string> &preprocessed)
 {
   language_filest language_files;
   language_files.set_message_handler(get_message_handler());
 
-  if(parse(file_name, language_files))
+  if(parse(file_name, language_files, preprocessed))
     return true;
 
   // we just typecheck one file here
@@ -625,6 +929,7 @@ compilet::compilet(cmdlinet &_cmdline, message_handlert &mh, bool Werror)
   : messaget(mh),
     ns(goto_model.symbol_table),
     cmdline(_cmdline),
+    cache(mh),
     warning_is_fatal(Werror),
     keep_file_local(
       // function-local is the old name and is still in use, but is misleading
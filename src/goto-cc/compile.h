@@ -14,12 +14,17 @@ Date: June 2006
 #ifndef CPROVER_GOTO_CC_COMPILE_H
 #define CPROVER_GOTO_CC_COMPILE_H
 
+#include <memory>
+
 #include <util/cmdline.h>
 #include <util/message.h>
+#include <util/optional.h>
 #include <util/rename_symbol.h>
 
 #include <goto-programs/goto_model.h>
 
+#include "compile_cache.h"
+
 class language_filest;
 class languaget;
 
@@ -35,6 +40,10 @@ public:
   std::string working_directory;
   std::string override_language;
   bool validate_goto_model = false;
+  /// Number of source files to compile concurrently, in separate processes
+  std::size_t jobs = 1;
+  /// Compress the goto binaries that are written
+  bool compress_goto_binary = false;
 
   enum { PREPROCESS_ONLY, // gcc -E
          COMPILE_ONLY, // gcc -c
@@ -65,13 +74,18 @@ public:
   bool find_library(const std::string &);
   bool add_files_from_archive(const std::string &file_name, bool thin_archive);
 
-  bool parse(const std::string &filename, language_filest &);
+  bool parse(
+    const std::string &filename,
+    language_filest &,
+    const optionalt<std::string> &preprocessed = {});
   bool parse_stdin(languaget &);
   bool doit();
   bool compile();
   bool link();
 
-  bool parse_source(const std::string &);
+  bool parse_source(
+    const std::string &,
+    const optionalt<std::string> &preprocessed = {});
 
   bool write_bin_object_file(const std::string &, const goto_modelt &);
 
@@ -94,6 +108,7 @@ public:
 
 protected:
   cmdlinet &cmdline;
+  compile_cachet cache;
   bool warning_is_fatal;
 
   /// \brief Whether to keep implementations of file-local symbols
@@ -108,6 +123,17 @@ protected:
 
   void convert_symbols(goto_functionst &dest);
 
+  std::unique_ptr<languaget> get_language(const std::string &file_name) const;
+  bool cache_key(
+    const std::string &file_name,
+    std::string &key,
+    std::string &preprocessed);
+  std::string object_file_name(const std::string &file_name) const;
+  bool compile_source_file(
+    const std::string &file_name,
+    const std::string &object_file);
+  bool compile_in_parallel();
+
   bool add_written_cprover_symbols(const symbol_tablet &symbol_table);
   std::map<irep_idt, symbolt> written_macros;
 
@@ -0,0 +1,236 @@
+/*******************************************************************\
+
+Module: Cache of Compiled Goto Object Files
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Compiled Goto Object Files
+
+#include "compile_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+#include <util/file_util.h>
+#include <util/string2int.h>
+#include <util/string_hash.h>
+#include <util/suffix.h>
+
+compile_cachet::compile_cachet(message_handlert &message_handler)
+  : messaget(message_handler), max_size(std::size_t(1024) << 20)
+{
+#ifndef _WIN32
+  const char *cache_directory = getenv("GOTO_CC_CACHE");
+  if(cache_directory == nullptr || *cache_directory == 0)
+    return;
+
+  if(!is_directory(cache_directory) && !create_directory(cache_directory))
+  {
+    warning() << "failed to create cache directory '" << cache_directory
+              << "', not using the cache" << eom;
+    return;
+  }
+
+  directory = cache_directory;
+
+  const char *size = getenv("GOTO_CC_CACHE_SIZE");
+  if(size != nullptr)
+  {
+    const auto mebibytes = string2optional_size_t(size);
+    if(mebibytes.has_value())
+      max_size = *mebibytes << 20;
+    else
+      warning() << "ignoring invalid GOTO_CC_CACHE_SIZE '" << size << "'"
+                << eom;
+  }
+#endif
+}
+
+std::string compile_cachet::entry_path(const std::string &key) const
+{
+  // two differently seeded hashes and the length make collisions unlikely
+  std::ostringstream file_name;
+  file_name << string_digest(key) << '-' << key.size() << ".gb";
+  return concat_dir_file(directory, file_name.str());
+}
+
+std::string compile_cachet::lookup(const std::string &key)
+{
+  PRECONDITION(enabled());
+
+  const std::string path = entry_path(key);
+
+#ifndef _WIN32
+  // mark as recently used
+  if(utime(path.c_str(), nullptr) == 0)
+  {
+    count("hits");
+    debug() << "Cache hit: " << path << eom;
+    return path;
+  }
+#endif
+
+  count("misses");
+  return std::string();
+}
+
+void compile_cachet::store(
+  const std::string &key,
+  const std::string &object_file)
+{
+  PRECONDITION(enabled());
+
+#ifndef _WIN32
+  const std::string path = entry_path(key);
+
+  // other processes may be storing or reading the same entry
+  const std::string temporary_path =
+    path + "." + std::to_string(getpid()) + ".tmp";
+  bool failed;
+  {
+    std::ifstream in(object_file, std::ios::binary);
+    std::ofstream out(temporary_path, std::ios::binary);
+    failed = !in || !out || !(out << in.rdbuf()) || !out.flush();
+  }
+
+  if(failed || std::rename(temporary_path.c_str(), path.c_str()) != 0)
+  {
+    file_remove(temporary_path);
+    warning() << "failed to add '" << object_file << "' to the cache" << eom;
+    return;
+  }
+
+  evict();
+#else
+  (void)key;
+  (void)object_file;
+#endif
+}
+
+/// Count one event in the file \p counter of the cache directory. Appending
+/// a byte is atomic, hence concurrent goto-cc processes don't lose counts.
+void compile_cachet::count(const char *counter)
+{
+  std::ofstream out(
+    concat_dir_file(directory, counter), std::ios::binary | std::ios::app);
+  out << '.';
+}
+
+std::size_t compile_cachet::get_count(const char *counter) const
+{
+  std::ifstream in(
+    concat_dir_file(directory, counter), std::ios::binary | std::ios::ate);
+  if(!in)
+    return 0;
+  return static_cast<std::size_t>(in.tellg());
+}
+
+/// Collect the entries of the cache with the time of their last use
+/// \return the total size of the entries in bytes
+std::size_t compile_cachet::scan(entriest &entries) const
+{
+  std::size_t total_size = 0;
+
+#ifndef _WIN32
+  DIR *dir = opendir(directory.c_str());
+  if(dir == nullptr)
+    return 0;
+
+  while(const dirent *entry = readdir(dir))
+  {
+    const std::string name = entry->d_name;
+    if(!has_suffix(name, ".gb"))
+      continue;
+
+    const std::string path = concat_dir_file(directory, name);
+    struct stat info;
+    if(stat(path.c_str(), &info) != 0)
+      continue;
+
+    entries.emplace_back(info.st_mtime, path);
+    total_size += static_cast<std::size_t>(info.st_size);
+  }
+
+  closedir(dir);
+#else
+  (void)entries;
+#endif
+
+  return total_size;
+}
+
+/// Remove the least recently used entries once the entries take up more
+/// than \ref max_size bytes, until they take up at most 90% of it
+void compile_cachet::evict()
+{
+#ifndef _WIN32
+  entriest entries;
+  std::size_t total_size = scan(entries);
+
+  if(total_size <= max_size)
+    return;
+
+  std::sort(entries.begin(), entries.end());
+
+  for(const auto &entry : entries)
+  {
+    if(total_size <= max_size / 10 * 9)
+      break;
+
+    struct stat info;
+    if(stat(entry.second.c_str(), &info) == 0 && file_remove(entry.second))
+    {
+      debug() << "Removing from cache: " << entry.second << eom;
+      const auto size = static_cast<std::size_t>(info.st_size);
+      total_size -= std::min(total_size, size);
+    }
+  }
+#endif
+}
+
+void compile_cachet::output_statistics(std::ostream &out) const
+{
+  if(!enabled())
+  {
+    out << "goto-cc cache: not enabled, set GOTO_CC_CACHE to a directory\n";
+    return;
+  }
+
+  const std::size_t hits = get_count("hits");
+  const std::size_t misses = get_count("misses");
+
+  out << "goto-cc cache: " << directory << '\n'
+      << "  hits:     " << hits << '\n'
+      << "  misses:   " << misses << '\n';
+
+  if(hits + misses != 0)
+  {
+    out << "  hit rate: " << std::fixed << std::setprecision(1)
+        << 100.0 * hits / (hits + misses) << "%\n";
+  }
+
+  entriest entries;
+  const std::size_t total_size = scan(entries);
+
+  out << "  entries:  " << entries.size() << '\n'
+      << "  size:     " << (total_size >> 20) << " MiB of "
+      << (max_size >> 20) << " MiB\n";
+}
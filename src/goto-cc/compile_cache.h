@@ -0,0 +1,62 @@
+/*******************************************************************\
+
+Module: Cache of Compiled Goto Object Files
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Compiled Goto Object Files
+
+#ifndef CPROVER_GOTO_CC_COMPILE_CACHE_H
+#define CPROVER_GOTO_CC_COMPILE_CACHE_H
+
+#include <cstddef>
+#include <ctime>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <util/message.h>
+
+/// A directory of goto object files, each stored under a hash of everything
+/// its contents depend on: the preprocessed source, the goto-cc version and
+/// the configuration. The directory is given in the environment variable
+/// GOTO_CC_CACHE. Once the files take up more than GOTO_CC_CACHE_SIZE
+/// mebibytes (default 1024), the least recently used ones are removed.
+/// Hits and misses are counted in the directory, across processes.
+class compile_cachet : public messaget
+{
+public:
+  explicit compile_cachet(message_handlert &message_handler);
+
+  bool enabled() const
+  {
+    return !directory.empty();
+  }
+
+  /// \return the cached object file for \p key, or the empty string
+  std::string lookup(const std::string &key);
+
+  /// Add a copy of \p object_file to the cache, as the object file for
+  /// \p key
+  void store(const std::string &key, const std::string &object_file);
+
+  void output_statistics(std::ostream &out) const;
+
+protected:
+  std::string directory;
+  std::size_t max_size;
+
+  std::string entry_path(const std::string &key) const;
+  void count(const char *counter);
+  std::size_t get_count(const char *counter) const;
+
+  typedef std::vector<std::pair<time_t, std::string>> entriest;
+  std::size_t scan(entriest &entries) const;
+  void evict();
+};
+
+#endif // CPROVER_GOTO_CC_COMPILE_CACHE_H
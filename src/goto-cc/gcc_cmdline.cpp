@@ -28,6 +28,7 @@ const char *goto_cc_options_with_separated_argument[]=
   "--native-linker",
   "--print-rejected-preprocessed-source",
   "--mangle-suffix",
+  "--jobs",
   nullptr
 };
 
@@ -53,6 +54,8 @@ const char *goto_cc_options_without_argument[]=
   "--validate-goto-model",
   "-?",
   "--export-file-local-symbols",
+  "--cache-statistics",
+  "--compress-goto-binary",
   nullptr
 };
 
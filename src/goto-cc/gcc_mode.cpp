@@ -40,6 +40,7 @@ Author: CM Wintersteiger, 2006
 #include <util/prefix.h>
 #include <util/replace_symbol.h>
 #include <util/run.h>
+#include <util/string2int.h>
 #include <util/suffix.h>
 #include <util/tempdir.h>
 #include <util/tempfile.h>
@@ -47,6 +48,7 @@ Author: CM Wintersteiger, 2006
 
 #include <goto-programs/read_goto_binary.h>
 
+#include "compile_cache.h"
 #include "hybrid_binary.h"
 #include "linker_script_merge.h"
 
@@ -387,6 +389,12 @@ int gcc_modet::doit()
     return EX_OK; // Exit!
   }
 
+  if(cmdline.isset("cache-statistics"))
+  {
+    compile_cachet(gcc_message_handler).output_statistics(std::cout);
+    return EX_OK;
+  }
+
   if(
     cmdline.isset("dumpmachine") || cmdline.isset("dumpspecs") ||
     cmdline.isset("dumpversion") || cmdline.isset("print-sysroot") ||
@@ -426,6 +434,12 @@ int gcc_modet::doit()
   // model validation
   compiler.validate_goto_model = cmdline.isset("validate-goto-model");
 
+  if(cmdline.isset("jobs"))
+    compiler.jobs = std::max<std::size_t>(
+      1, safe_string2size_t(cmdline.get_value("jobs")));
+
+  compiler.compress_goto_binary = cmdline.isset("compress-goto-binary");
+
   // determine actions to be undertaken
   if(cmdline.isset('S'))
     compiler.mode=compilet::ASSEMBLE_ONLY;
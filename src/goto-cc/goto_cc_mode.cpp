@@ -66,6 +66,10 @@ void goto_cc_modet::help()
   " --native-assembler cmd      command to invoke as assembler (goto-as only)\n"
   " --print-rejected-preprocessed-source file\n"
   "                             copy failing (preprocessed) source to file\n"
+  " --jobs n                    compile up to n source files concurrently\n"
+  " --cache-statistics          show statistics of the cache of object files\n"
+  "                             in the directory given by GOTO_CC_CACHE\n"
+  " --compress-goto-binary      compress the goto binaries that are written\n"
   "\n";
   // clang-format on
 }
@@ -0,0 +1,181 @@
+/*******************************************************************\
+
+Module: Goto Verifier that Adapts Loop Unwinding Bounds
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Goto Verifier that Adapts Loop Unwinding Bounds
+
+#ifndef CPROVER_GOTO_CHECKER_ADAPTIVE_UNWINDING_VERIFIER_H
+#define CPROVER_GOTO_CHECKER_ADAPTIVE_UNWINDING_VERIFIER_H
+
+#include "all_properties_verifier_with_trace_storage.h"
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <util/make_unique.h>
+
+#include <goto-instrument/unwindset.h>
+
+/// Determines the status of all properties using unwinding bounds that are
+/// raised only for the loops that need them: starting from the bound given
+/// by the "unwind" option, verification is repeated with the bound of each
+/// loop whose unwinding assertion fails doubled (up to "unwind-max") until
+/// all unwinding assertions hold or no bound can be raised any further.
+/// The results of the last round are reported, together with the bounds
+/// that were chosen, in the format of the `--unwindset` option. If the
+/// "no-unwinding-assertions" option is set, a final round checks the
+/// properties with the chosen bounds but without unwinding assertions.
+template <class incremental_goto_checkerT>
+class adaptive_unwinding_verifiert : public goto_verifiert
+{
+public:
+  adaptive_unwinding_verifiert(
+    const optionst &options,
+    ui_message_handlert &ui_message_handler,
+    abstract_goto_modelt &goto_model)
+    : goto_verifiert(options, ui_message_handler),
+      goto_model(goto_model),
+      round_options(options),
+      max_bound(options.get_unsigned_int_option("unwind-max"))
+  {
+    // we need the unwinding assertions to find the loops to raise, even if
+    // they are not to be reported
+    round_options.set_option("unwinding-assertions", true);
+    round_options.set_option("paths-symex-explore-all", true);
+  }
+
+  resultt operator()() override
+  {
+    while(true)
+    {
+      ++rounds;
+      round_options.set_option("unwindset", unwindset_option());
+
+      verifier = util_make_unique<
+        all_properties_verifier_with_trace_storaget<incremental_goto_checkerT>>(
+        round_options, ui_message_handler, goto_model);
+      const resultt result = (*verifier)();
+      properties = verifier->get_properties();
+
+      if(raise_bounds())
+        continue;
+
+      if(!options.get_bool_option("no-unwinding-assertions"))
+        return result;
+
+      ++rounds;
+      round_options.set_option("unwinding-assertions", false);
+      round_options.set_option(
+        "paths-symex-explore-all",
+        options.get_bool_option("paths-symex-explore-all"));
+      verifier = util_make_unique<
+        all_properties_verifier_with_trace_storaget<incremental_goto_checkerT>>(
+        round_options, ui_message_handler, goto_model);
+      return (*verifier)();
+    }
+  }
+
+  void report() override
+  {
+    PRECONDITION(verifier != nullptr);
+    verifier->report();
+
+    log.status() << "Adaptive unwinding finished after " << rounds
+                 << (rounds == 1 ? " round" : " rounds");
+    if(bounds.empty())
+    {
+      log.status() << ", no bounds raised" << messaget::eom;
+    }
+    else
+    {
+      log.status() << ", use --unwindset ";
+      bool first = true;
+      for(const auto &bound : bounds)
+      {
+        log.status() << (first ? "" : ",") << bound.first << ':'
+                     << bound.second;
+        first = false;
+      }
+      log.status() << messaget::eom;
+    }
+  }
+
+protected:
+  abstract_goto_modelt &goto_model;
+  optionst round_options;
+  const unsigned max_bound;
+
+  /// Bounds of the loops that have been raised
+  std::map<irep_idt, unsigned> bounds;
+
+  std::unique_ptr<
+    all_properties_verifier_with_trace_storaget<incremental_goto_checkerT>>
+    verifier;
+  std::size_t rounds = 0;
+
+  /// The bounds given by the user followed by the raised ones, which take
+  /// precedence.
+  std::list<std::string> unwindset_option() const
+  {
+    std::list<std::string> result = options.get_list_option("unwindset");
+    for(const auto &bound : bounds)
+      result.push_back(
+        id2string(bound.first) + ":" + std::to_string(bound.second));
+    return result;
+  }
+
+  /// Double the bounds of all loops with a failing unwinding assertion.
+  /// \return true if at least one bound has been raised
+  bool raise_bounds()
+  {
+    unwindsett unwindset;
+    unwindset.parse_unwind(round_options.get_option("unwind"));
+    unwindset.parse_unwindset(round_options.get_list_option("unwindset"));
+
+    bool raised = false;
+
+    for(const auto &property_pair : properties)
+    {
+      // unwinding assertions are attached to the backwards goto of the loop
+      const property_infot &property_info = property_pair.second;
+      if(
+        property_info.status != property_statust::FAIL ||
+        !property_info.pc->is_goto())
+      {
+        continue;
+      }
+
+      const irep_idt loop_id = goto_programt::loop_id(
+        property_info.pc->source_location.get_function(), *property_info.pc);
+      const optionalt<unsigned> limit = unwindset.get_limit(loop_id, 0);
+      if(!limit.has_value())
+        continue;
+
+      if(*limit >= max_bound)
+      {
+        log.warning() << "Unwinding assertion of loop " << loop_id
+                      << " fails at the maximum bound " << max_bound
+                      << messaget::eom;
+        continue;
+      }
+
+      const unsigned new_bound = std::min(std::max(2 * *limit, 1u), max_bound);
+      log.status() << "Raising unwinding bound of loop " << loop_id << " to "
+                   << new_bound << messaget::eom;
+      bounds[loop_id] = new_bound;
+      raised = true;
+    }
+
+    return raised;
+  }
+};
+
+#endif // CPROVER_GOTO_CHECKER_ADAPTIVE_UNWINDING_VERIFIER_H
@@ -210,6 +210,11 @@ void slice(
     // we should build a thread-aware SSA slicer
     msg.statistics() << "no slicing due to threads" << messaget::eom;
   }
+  else if(options.get_bool_option("stream-equation"))
+  {
+    // steps have been passed to the decision procedure already
+    msg.statistics() << "no slicing due to streaming" << messaget::eom;
+  }
   else
   {
     if(options.get_bool_option("slice-formula"))
@@ -253,7 +258,8 @@ void update_properties_status_from_symex_target_equation(
     const auto status = step.cond_expr.is_true() ? property_statust::PASS
                                                  : property_statust::UNKNOWN;
     auto emplace_result = properties.emplace(
-      property_id, property_infot{step.source.pc, step.comment, status});
+      property_id,
+      property_infot{step.source.pc, id2string(step.comment), status});
 
     if(emplace_result.second)
     {
@@ -177,6 +177,7 @@ void run_property_decider(
   "(show-vcc)" \
   "(show-goto-symex-steps)" \
   "(slice-formula)" \
+  "(stream-equation)" \
   "(unwinding-assertions)" \
   "(no-unwinding-assertions)" \
   "(no-pretty-names)" \
@@ -195,7 +196,8 @@ void run_property_decider(
   "(incremental-loop):" \
   "(unwind-min):" \
   "(unwind-max):" \
-  "(ignore-properties-before-unwind-min)"
+  "(ignore-properties-before-unwind-min)" \
+  "(adaptive-unwind)"
 
 #define HELP_BMC \
   " --paths [strategy]           explore paths one at a time\n" \
@@ -221,12 +223,20 @@ void run_property_decider(
   "                              of loop L\n" \
   "                              (use --show-loops to get the loop IDs)\n" \
   " --unwind-min nr              start incremental-loop after nr unwindings\n" \
-  " --unwind-max nr              stop incremental-loop after nr unwindings\n" \
+  " --unwind-max nr              stop incremental-loop or adaptive-unwind\n" \
+  "                              after nr unwindings\n" \
   " --ignore-properties-before-unwind-min\n" \
   "                              do not check properties before unwind-min\n" \
   "                              when using incremental-loop\n" \
+  " --adaptive-unwind            starting from --unwind, double the bounds\n" \
+  "                              of loops whose unwinding assertion fails\n" \
+  "                              until all hold or --unwind-max is reached\n" \
   " --show-vcc                   show the verification conditions\n" \
   " --slice-formula              remove assignments unrelated to property\n" \
+  " --stream-equation            pass the equation to the solver while it\n" \
+  "                              is being built (single-threaded programs,\n" \
+  "                              no slicing, no --paths or\n" \
+  "                              --incremental-loop)\n" \
   " --unwinding-assertions       generate unwinding assertions (cannot be\n" \
   "                              used with --cover or --partial-loops)\n" \
   " --partial-loops              permit paths with partial loops\n" \
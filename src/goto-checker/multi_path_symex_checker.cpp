@@ -17,6 +17,11 @@ Author: Daniel Kroening, Peter Schrammel
 #include "counterexample_beautification.h"
 #include "goto_symex_fault_localizer.h"
 
+/// Number of new steps of the equation after which symex passes them to the
+/// decision procedure with --stream-equation; batches amortise walking the
+/// equation and logging per conversion
+static const std::size_t stream_equation_batch_size = 10000;
+
 multi_path_symex_checkert::multi_path_symex_checkert(
   const optionst &options,
   ui_message_handlert &ui_message_handler,
@@ -25,6 +30,11 @@ multi_path_symex_checkert::multi_path_symex_checkert(
     equation_generated(false),
     property_decider(options, ui_message_handler, equation, ns)
 {
+  if(options.get_bool_option("stream-equation"))
+  {
+    symex.stream_equation(
+      property_decider.get_decision_procedure(), stream_equation_batch_size);
+  }
 }
 
 incremental_goto_checkert::resultt multi_path_symex_checkert::
@@ -69,10 +79,31 @@ operator()(propertiest &properties)
 std::chrono::duration<double>
 multi_path_symex_checkert::prepare_property_decider(propertiest &properties)
 {
-  std::chrono::duration<double> solver_runtime = ::prepare_property_decider(
-    properties, equation, property_decider, ui_message_handler);
+  if(!options.get_bool_option("stream-equation"))
+  {
+    std::chrono::duration<double> solver_runtime = ::prepare_property_decider(
+      properties, equation, property_decider, ui_message_handler);
+
+    return solver_runtime;
+  }
+
+  // most of the equation has been converted during symex already
+  auto solver_start = std::chrono::steady_clock::now();
+
+  messaget log(ui_message_handler);
+  log.status()
+    << "Passing remaining SSA steps to "
+    << property_decider.get_decision_procedure().decision_procedure_text()
+    << messaget::eom;
+
+  equation.convert_new_steps(property_decider.get_decision_procedure());
+  equation.convert_assertions(property_decider.get_decision_procedure());
+  property_decider.update_properties_goals_from_symex_target_equation(
+    properties);
+  property_decider.convert_goals();
 
-  return solver_runtime;
+  auto solver_stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(solver_stop - solver_start);
 }
 
 void multi_path_symex_checkert::run_property_decider(
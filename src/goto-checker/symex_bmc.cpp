@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <limits>
 
+#include <util/exception_utils.h>
 #include <util/simplify_expr.h>
 #include <util/source_location.h>
 
@@ -72,6 +73,23 @@ void symex_bmct::symex_step(
 
   goto_symext::symex_step(get_goto_function, state);
 
+  if(stream_decision_procedure != nullptr)
+  {
+    // the memory model adds steps for shared accesses once symex is done,
+    // which does not fit converting the equation in order
+    if(state.threads.size() > 1)
+    {
+      throw unsupported_operation_exceptiont(
+        "--stream-equation does not support multi-threaded programs");
+    }
+
+    if(target.SSA_steps.size() >= streamed_steps + stream_batch_size)
+    {
+      target.convert_new_steps(*stream_decision_procedure);
+      streamed_steps = target.SSA_steps.size();
+    }
+  }
+
   if(
     record_coverage &&
     // avoid an invalid iterator in state.source.pc
@@ -22,6 +22,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "symex_coverage.h"
 
+class decision_proceduret;
+
 class symex_bmct : public goto_symext
 {
 public:
@@ -84,7 +86,24 @@ public:
 
   unwindsett unwindset;
 
+  /// Pass the equation to \p decision_procedure while it is being built,
+  /// whenever at least \p batch_size new steps have been recorded (see
+  /// symex_target_equationt::convert_new_steps). The remaining steps and the
+  /// assertions have to be converted by the caller once symex has finished.
+  void stream_equation(
+    decision_proceduret &decision_procedure,
+    std::size_t batch_size)
+  {
+    stream_decision_procedure = &decision_procedure;
+    stream_batch_size = batch_size;
+  }
+
 protected:
+  /// Decision procedure the equation is streamed into, if any
+  decision_proceduret *stream_decision_procedure = nullptr;
+  std::size_t stream_batch_size = 0;
+  std::size_t streamed_steps = 0;
+
   /// Callbacks that may provide an unwind/do-not-unwind decision for a loop
   std::vector<loop_unwind_handlert> loop_unwind_handlers;
 
@@ -13,6 +13,7 @@ Date: April 2016
 
 #include "change_impact.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include <goto-programs/goto_model.h>
@@ -209,6 +210,9 @@ public:
 
   void operator()();
 
+  /// \copydoc ::affected_properties
+  std::set<irep_idt> affected_properties();
+
 protected:
   impact_modet impact_mode;
   bool compact_output;
@@ -241,6 +245,8 @@ protected:
 
   goto_functions_change_impactt old_change_impact, new_change_impact;
 
+  void compute_change_impact();
+
   void change_impact(const irep_idt &function_id);
 
   void change_impact(
@@ -485,7 +491,7 @@ void change_impactt::propogate_dep_back(
   }
 }
 
-void change_impactt::operator()()
+void change_impactt::compute_change_impact()
 {
   // sorted iteration over intersection(old functions, new functions)
   typedef std::map<irep_idt,
@@ -514,6 +520,11 @@ void change_impactt::operator()()
       ++ito;
     }
   }
+}
+
+void change_impactt::operator()()
+{
+  compute_change_impact();
 
   goto_functions_change_impactt::const_iterator oc_it=
     old_change_impact.begin();
@@ -555,6 +566,104 @@ void change_impactt::operator()()
   }
 }
 
+std::set<irep_idt> change_impactt::affected_properties()
+{
+  compute_change_impact();
+
+  std::set<irep_idt> new_properties;
+  forall_goto_functions(f_it, new_goto_functions)
+  {
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      if(i_it->is_assert())
+        new_properties.insert(i_it->source_location.get_property_id());
+    }
+  }
+
+  std::set<irep_idt> result;
+
+  // Instructions may have been recorded under the function the change
+  // originates from, hence only use the instructions themselves.
+  for(const auto &function_impact : new_change_impact)
+  {
+    for(const auto &instruction_impact : function_impact.second)
+    {
+      if(
+        instruction_impact.second != SAME &&
+        instruction_impact.first->is_assert())
+      {
+        result.insert(
+          instruction_impact.first->source_location.get_property_id());
+      }
+    }
+  }
+
+  // properties that depended on removed instructions, as far as they still
+  // exist
+  for(const auto &function_impact : old_change_impact)
+  {
+    for(const auto &instruction_impact : function_impact.second)
+    {
+      if(
+        (instruction_impact.second & (DEL_DATA_DEP | DEL_CTRL_DEP)) &&
+        instruction_impact.first->is_assert())
+      {
+        const irep_idt &property_id =
+          instruction_impact.first->source_location.get_property_id();
+        if(new_properties.find(property_id) != new_properties.end())
+          result.insert(property_id);
+      }
+    }
+  }
+
+  // Property identifiers number the assertions of a function in order: once
+  // assertions have been added or removed, the identifiers of the others may
+  // denote different assertions than in the old program, and none of their
+  // results can be reused.
+  forall_goto_functions(f_it, new_goto_functions)
+  {
+    const unified_difft::goto_program_difft diff =
+      unified_diff.get_diff(f_it->first);
+    const bool assertions_changed = std::any_of(
+      diff.begin(),
+      diff.end(),
+      [](const unified_difft::goto_program_difft::value_type &entry) {
+        return entry.second != unified_difft::differencet::SAME &&
+               entry.first->is_assert();
+      });
+
+    if(!assertions_changed)
+      continue;
+
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      if(i_it->is_assert())
+        result.insert(i_it->source_location.get_property_id());
+    }
+  }
+
+  // functions without counterpart in the old program have not been diffed
+  forall_goto_functions(f_it, new_goto_functions)
+  {
+    goto_functionst::function_mapt::const_iterator old_f_it =
+      old_goto_functions.function_map.find(f_it->first);
+    if(
+      old_f_it != old_goto_functions.function_map.end() &&
+      old_f_it->second.body_available())
+    {
+      continue;
+    }
+
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      if(i_it->is_assert())
+        result.insert(i_it->source_location.get_property_id());
+    }
+  }
+
+  return result;
+}
+
 void change_impactt::output_change_impact(
   const irep_idt &function_id,
   const goto_program_change_impactt &c_i,
@@ -751,3 +860,11 @@ void change_impact(
   change_impactt c(model_old, model_new, impact_mode, compact_output);
   c();
 }
+
+std::set<irep_idt> affected_properties(
+  const goto_modelt &model_old,
+  const goto_modelt &model_new)
+{
+  change_impactt c(model_old, model_new, impact_modet::FORWARD, true);
+  return c.affected_properties();
+}
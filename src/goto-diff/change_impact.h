@@ -14,6 +14,10 @@ Date: April 2016
 #ifndef CPROVER_GOTO_DIFF_CHANGE_IMPACT_H
 #define CPROVER_GOTO_DIFF_CHANGE_IMPACT_H
 
+#include <set>
+
+#include <util/irep.h>
+
 class goto_modelt;
 enum class impact_modet { FORWARD, BACKWARD, BOTH };
 
@@ -23,4 +27,18 @@ void change_impact(
   impact_modet impact_mode,
   bool compact_output);
 
+/// Determine the properties of \p model_new whose verification result may
+/// differ from the one in \p model_old: those that are new, or that are data
+/// or control dependent on instructions that have been added or removed, all
+/// properties of functions in which assertions have been added or removed (as
+/// the identifiers of the others may now denote different assertions), and
+/// all properties of functions that do not exist in \p model_old.
+/// Verification after a change can be restricted to these properties (e.g.,
+/// using cbmc's --property option), reusing the earlier results for all
+/// others.
+/// \return the identifiers of the affected properties
+std::set<irep_idt> affected_properties(
+  const goto_modelt &model_old,
+  const goto_modelt &model_new);
+
 #endif // CPROVER_GOTO_DIFF_CHANGE_IMPACT_H
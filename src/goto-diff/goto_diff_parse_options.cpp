@@ -18,6 +18,7 @@ Author: Peter Schrammel
 
 #include <util/config.h>
 #include <util/exit_codes.h>
+#include <util/json.h>
 #include <util/make_unique.h>
 #include <util/options.h>
 #include <util/version.h>
@@ -290,6 +291,34 @@ int goto_diff_parse_optionst::doit()
     return CPROVER_EXIT_SUCCESS;
   }
 
+  if(cmdline.isset("affected-properties"))
+  {
+    const std::set<irep_idt> properties =
+      affected_properties(goto_model1, goto_model2);
+
+    switch(ui_message_handler.get_ui())
+    {
+    case ui_message_handlert::uit::PLAIN:
+      for(const auto &property_id : properties)
+        log.result() << property_id << messaget::eom;
+      break;
+    case ui_message_handlert::uit::JSON_UI:
+    {
+      json_arrayt json_properties;
+      for(const auto &property_id : properties)
+        json_properties.push_back(json_stringt(property_id));
+      log.result() << json_objectt{{"affectedProperties", json_properties}}
+                   << messaget::eom;
+      break;
+    }
+    case ui_message_handlert::uit::XML_UI:
+      log.error() << "XML output not supported yet" << messaget::eom;
+      return CPROVER_EXIT_USAGE_ERROR;
+    }
+
+    return CPROVER_EXIT_SUCCESS;
+  }
+
   if(cmdline.isset("unified") ||
      cmdline.isset('u'))
   {
@@ -405,6 +434,8 @@ void goto_diff_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     "  --backward-impact           output unified diff with forward&backward/forward/backward dependencies\n"
     " --compact-output             output dependencies in compact mode\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --affected-properties        list the properties of new that may have a different result than in old\n"
     "\n"
     "Program instrumentation options:\n"
     HELP_GOTO_CHECK
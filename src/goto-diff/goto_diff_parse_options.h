@@ -36,7 +36,8 @@ class optionst;
   OPT_FLUSH \
   OPT_TIMESTAMP \
   "u(unified)(change-impact)(forward-impact)(backward-impact)" \
-  "(compact-output)"
+  "(compact-output)" \
+  "(affected-properties)"
 // clang-format on
 
 class goto_diff_parse_optionst : public parse_options_baset
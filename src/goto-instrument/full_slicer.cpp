@@ -14,6 +14,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/find_symbols.h>
 #include <util/cprover_prefix.h>
+#include <util/irep_hash.h>
+#include <util/make_unique.h>
 
 #include <goto-programs/remove_skip.h>
 
@@ -188,7 +190,7 @@ void full_slicert::add_jumps(
 }
 
 void full_slicert::fixedpoint(
-  goto_functionst &goto_functions,
+  const goto_functionst &goto_functions,
   queuet &queue,
   jumpst &jumps,
   decl_deadt &decl_dead,
@@ -251,10 +253,10 @@ static bool implicit(goto_programt::const_targett target)
   return s.get_identifier()==CPROVER_PREFIX "rounding_mode";
 }
 
-void full_slicert::operator()(
-  goto_functionst &goto_functions,
-  const namespacet &ns,
-  const slicing_criteriont &criterion)
+void full_slicert::compute_slice(
+  const goto_functionst &goto_functions,
+  const slicing_criteriont &criterion,
+  const dependence_grapht &dep_graph)
 {
   // build the CFG data structure
   cfg(goto_functions);
@@ -295,12 +297,37 @@ void full_slicert::operator()(
     }
   }
 
+  // compute the fixedpoint
+  fixedpoint(goto_functions, queue, jumps, decl_dead, dep_graph);
+}
+
+std::unordered_set<unsigned> full_slicert::required_locations(
+  const goto_functionst &goto_functions,
+  const slicing_criteriont &criterion,
+  const dependence_grapht &dep_graph)
+{
+  compute_slice(goto_functions, criterion, dep_graph);
+
+  std::unordered_set<unsigned> result;
+  for(const auto &entry : cfg.entries())
+  {
+    if(cfg[entry.second].node_required)
+      result.insert(entry.first->location_number);
+  }
+
+  return result;
+}
+
+void full_slicert::operator()(
+  goto_functionst &goto_functions,
+  const namespacet &ns,
+  const slicing_criteriont &criterion)
+{
   // compute program dependence graph (and post-dominators)
   dependence_grapht dep_graph(ns);
   dep_graph(goto_functions, ns);
 
-  // compute the fixedpoint
-  fixedpoint(goto_functions, queue, jumps, decl_dead, dep_graph);
+  compute_slice(goto_functions, criterion, dep_graph);
 
   // now replace those instructions that are not needed
   // by skips
@@ -382,6 +409,82 @@ void property_slicer(
   property_slicer(goto_model.goto_functions, ns, properties);
 }
 
+persistent_full_slicert::persistent_full_slicert(
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+  : goto_functions(goto_functions), ns(ns)
+{
+  update();
+}
+
+persistent_full_slicert::~persistent_full_slicert() = default;
+
+std::map<irep_idt, std::size_t>
+persistent_full_slicert::hash_functions(const goto_functionst &goto_functions)
+{
+  std::map<irep_idt, std::size_t> result;
+
+  forall_goto_functions(f_it, goto_functions)
+  {
+    std::size_t hash = 0;
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      hash = hash_combine(hash, i_it->location_number);
+      hash = hash_combine(hash, i_it->type);
+      hash = hash_combine(hash, i_it->code.hash());
+      hash = hash_combine(hash, i_it->guard.hash());
+      for(const auto &target : i_it->targets)
+        hash = hash_combine(hash, target->location_number);
+    }
+    result[f_it->first] = hash;
+  }
+
+  return result;
+}
+
+bool persistent_full_slicert::update()
+{
+  auto new_hashes = hash_functions(goto_functions);
+  if(dep_graph && new_hashes == function_hashes)
+    return false;
+
+  // Reaching definitions and value sets are computed for the whole program,
+  // hence a change to any function requires a new dependence graph.
+  dep_graph = util_make_unique<dependence_grapht>(ns);
+  (*dep_graph)(goto_functions, ns);
+  function_hashes = std::move(new_hashes);
+
+  return true;
+}
+
+void persistent_full_slicert::operator()(
+  goto_functionst &goto_functions_copy,
+  const slicing_criteriont &criterion) const
+{
+  PRECONDITION(hash_functions(goto_functions_copy) == function_hashes);
+
+  // the slice is computed on the program the dependence graph refers to and
+  // then transferred to the copy via the location numbers
+  const std::unordered_set<unsigned> required =
+    full_slicert().required_locations(goto_functions, criterion, *dep_graph);
+
+  Forall_goto_functions(f_it, goto_functions_copy)
+    if(f_it->second.body_available())
+    {
+      Forall_goto_program_instructions(i_it, f_it->second.body)
+      {
+        if(
+          !i_it->is_end_function() && // always retained
+          required.find(i_it->location_number) == required.end())
+        {
+          i_it->turn_into_skip();
+        }
+      }
+    }
+
+  remove_skip(goto_functions_copy);
+}
+
 slicing_criteriont::~slicing_criteriont()
 {
 }
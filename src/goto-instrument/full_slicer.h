@@ -14,6 +14,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-programs/goto_model.h>
 
+#include <map>
+#include <memory>
+
+class dependence_grapht;
+
 void full_slicer(
   goto_functionst &,
   const namespacet &);
@@ -43,4 +48,46 @@ void full_slicer(
   const namespacet &ns,
   const slicing_criteriont &criterion);
 
+/// Slices a program for any number of slicing criteria. The program
+/// dependence graph, the most expensive part of slicing, is computed once and
+/// kept for all slices. The program itself is left unchanged: each slice is
+/// applied to a copy of it.
+class persistent_full_slicert
+{
+public:
+  /// \param goto_functions: the program to slice, which must have unique
+  ///   location numbers and must outlive this object
+  /// \param ns: namespace of the program
+  persistent_full_slicert(
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  ~persistent_full_slicert();
+
+  /// Slice \p goto_functions, which must be a copy of the program given to
+  /// the constructor in its current state, for \p criterion.
+  void operator()(
+    goto_functionst &goto_functions,
+    const slicing_criteriont &criterion) const;
+
+  /// Bring the dependence graph up to date after the program given to the
+  /// constructor has been transformed (and its location numbers have been
+  /// updated). The graph is only recomputed if the instructions of any
+  /// function have changed.
+  /// \return true if the dependence graph was recomputed
+  bool update();
+
+protected:
+  const goto_functionst &goto_functions;
+  const namespacet &ns;
+  std::unique_ptr<dependence_grapht> dep_graph;
+
+  /// Hash of the instructions of each function, for the program state the
+  /// dependence graph was computed for
+  std::map<irep_idt, std::size_t> function_hashes;
+
+  static std::map<irep_idt, std::size_t>
+  hash_functions(const goto_functionst &goto_functions);
+};
+
 #endif // CPROVER_GOTO_INSTRUMENT_FULL_SLICER_H
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <stack>
 #include <vector>
 #include <list>
+#include <unordered_set>
 
 #include <goto-programs/goto_functions.h>
 #include <goto-programs/cfg.h>
@@ -43,6 +44,17 @@ public:
     const namespacet &ns,
     const slicing_criteriont &criterion);
 
+  /// Determine the instructions of \p goto_functions that \p criterion
+  /// depends on, without changing the program.
+  /// \param goto_functions: program with unique location numbers
+  /// \param criterion: the slicing criterion
+  /// \param dep_graph: dependence graph computed for \p goto_functions
+  /// \return the location numbers of the instructions in the slice
+  std::unordered_set<unsigned> required_locations(
+    const goto_functionst &goto_functions,
+    const slicing_criteriont &criterion,
+    const dependence_grapht &dep_graph);
+
 protected:
   struct cfg_nodet
   {
@@ -65,8 +77,13 @@ protected:
   typedef std::list<cfgt::entryt> jumpst;
   typedef std::unordered_map<irep_idt, queuet> decl_deadt;
 
+  void compute_slice(
+    const goto_functionst &goto_functions,
+    const slicing_criteriont &criterion,
+    const dependence_grapht &dep_graph);
+
   void fixedpoint(
-    goto_functionst &goto_functions,
+    const goto_functionst &goto_functions,
     queuet &queue,
     jumpst &jumps,
     decl_deadt &decl_dead,
@@ -86,6 +86,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "dot.h"
 #include "dump_c.h"
 #include "full_slicer.h"
+#include "full_slicer_class.h"
 #include "function.h"
 #include "havoc_loops.h"
 #include "horn_encoding.h"
@@ -893,8 +894,15 @@ int goto_instrument_parse_optionst::doit()
 
       if(write_goto_binary(cmdline.args[1], goto_model, ui_message_handler))
         return CPROVER_EXIT_CONVERSION_FAILED;
-      else
-        return CPROVER_EXIT_SUCCESS;
+
+      if(
+        cmdline.isset("full-slice-each-property") &&
+        write_property_slices(cmdline.args[1]))
+      {
+        return CPROVER_EXIT_CONVERSION_FAILED;
+      }
+
+      return CPROVER_EXIT_SUCCESS;
     }
     else if(cmdline.args.size() < 2)
     {
@@ -911,6 +919,54 @@ int goto_instrument_parse_optionst::doit()
 // NOLINTNEXTLINE(readability/fn_size)
 }
 
+bool goto_instrument_parse_optionst::write_property_slices(
+  const std::string &prefix)
+{
+  std::list<std::string> properties;
+  if(cmdline.isset("property"))
+    properties = cmdline.get_values("property");
+  else
+  {
+    forall_goto_functions(f_it, goto_model.goto_functions)
+      forall_goto_program_instructions(i_it, f_it->second.body)
+        if(i_it->is_assert())
+        {
+          const irep_idt &property_id = i_it->source_location.get_property_id();
+          if(!property_id.empty())
+            properties.push_back(id2string(property_id));
+        }
+  }
+
+  // the dependence graph is computed once and shared by all slices
+  const namespacet ns(goto_model.symbol_table);
+  persistent_full_slicert slicer(goto_model.goto_functions, ns);
+
+  for(const auto &property : properties)
+  {
+    goto_functionst slice;
+    slice.copy_from(goto_model.goto_functions);
+    slicer(slice, properties_criteriont({property}));
+
+    const std::string file_name = prefix + "." + property;
+    log.status() << "Writing slice for property " << property << " to '"
+                 << file_name << "'" << messaget::eom;
+
+#ifdef _MSC_VER
+    std::ofstream out(widen(file_name), std::ios::binary);
+#else
+    std::ofstream out(file_name, std::ios::binary);
+#endif
+    if(!out || write_goto_binary(out, goto_model.symbol_table, slice))
+    {
+      log.error() << "failed to write to '" << file_name << "'"
+                  << messaget::eom;
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void goto_instrument_parse_optionst::do_indirect_call_and_rtti_removal(
   bool force)
 {
@@ -921,7 +977,11 @@ void goto_instrument_parse_optionst::do_indirect_call_and_rtti_removal(
 
   log.status() << "Function Pointer Removal" << messaget::eom;
   remove_function_pointers(
-    ui_message_handler, goto_model, cmdline.isset("pointer-check"));
+    ui_message_handler,
+    goto_model,
+    cmdline.isset("pointer-check"),
+    false,
+    cmdline.isset("points-to-function-pointers"));
   log.status() << "Virtual function removal" << messaget::eom;
   remove_virtual_functions(goto_model);
   log.status() << "Cleaning inline assembler statements" << messaget::eom;
@@ -1653,6 +1713,16 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     }
   }
 
+  if(cmdline.isset("full-slice-each-property"))
+  {
+    do_indirect_call_and_rtti_removal();
+    do_remove_returns();
+
+    // the slices are computed when writing the program, which must have
+    // unique location numbers by then
+    goto_model.goto_functions.update();
+  }
+
   // splice option
   if(cmdline.isset("splice-call"))
   {
@@ -1830,6 +1900,9 @@ void goto_instrument_parse_optionst::help()
     HELP_REACHABILITY_SLICER
     " --full-slice                 slice away instructions that don't affect assertions\n" // NOLINT(*)
     " --property id                slice with respect to specific property only\n" // NOLINT(*)
+    " --full-slice-each-property   also write a full slice of the program for each\n" // NOLINT(*)
+    "                              property (or each one given with --property)\n" // NOLINT(*)
+    "                              to <out>.<property id>\n"
     " --slice-global-inits         slice away initializations of unused global variables\n" // NOLINT(*)
     " --aggressive-slice           remove bodies of any functions not on the shortest path between\n" // NOLINT(*)
     "                              the start function and the function containing the property(s)\n" // NOLINT(*)
@@ -1851,6 +1924,9 @@ void goto_instrument_parse_optionst::help()
     " --no-caching                 disable caching of intermediate results during transitive function inlining\n" // NOLINT(*)
     " --log <file>                 log in json format which code segments were inlined, use with --function-inline\n" // NOLINT(*)
     " --remove-function-pointers   replace function pointers by case statement over function calls\n" // NOLINT(*)
+    " --points-to-function-pointers\n"
+    "                              only consider the functions a points-to analysis\n" // NOLINT(*)
+    "                              finds when replacing function pointers\n"
     HELP_REMOVE_CALLS_NO_BODY
     HELP_REMOVE_CONST_FUNCTION_POINTERS
     " --add-library                add models of C library functions\n"
@@ -78,12 +78,13 @@ Author: Daniel Kroening, kroening@kroening.com
   "(custom-bitvector-analysis)" \
   "(show-struct-alignment)(interval-analysis)(show-intervals)" \
   "(show-uninitialized)(show-locations)" \
-  "(full-slice)(reachability-slice)(slice-global-inits)" \
+  "(full-slice)(full-slice-each-property)" \
+  "(reachability-slice)(slice-global-inits)" \
   "(fp-reachability-slice):" \
   "(inline)(partial-inline)(function-inline):(log):(no-caching)" \
   OPT_REMOVE_CONST_FUNCTION_POINTERS \
   "(print-internal-representation)" \
-  "(remove-function-pointers)" \
+  "(remove-function-pointers)(points-to-function-pointers)" \
   "(show-claims)(property):" \
   "(show-symbol-table)(show-points-to)(show-rw-set)" \
   "(cav11)" \
@@ -151,6 +152,11 @@ protected:
   void do_partial_inlining();
   void do_remove_returns();
 
+  /// Write a full slice of the program for each property to
+  /// \p prefix followed by a dot and the property id
+  /// \return true on error
+  bool write_property_slices(const std::string &prefix);
+
   bool function_pointer_removal_done;
   bool partial_inlining_done;
   bool remove_returns_done;
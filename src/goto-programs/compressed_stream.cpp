@@ -0,0 +1,137 @@
+/*******************************************************************\
+
+Module: Block-Compressed Streams
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Stream buffers that compress data in blocks, for goto binaries
+
+#include "compressed_stream.h"
+
+#include <istream>
+#include <ostream>
+
+#include <util/exception_utils.h>
+#include <util/irep_serialization.h>
+
+#include <miniz/miniz.h>
+
+/// The size of the blocks that are compressed
+static const std::size_t block_size = 1 << 20;
+
+/// The largest block accepted when reading, to reject corrupt sizes before
+/// allocating memory for them
+static const std::size_t max_block_size = 1 << 26;
+
+deflate_streambuft::deflate_streambuft(std::ostream &out)
+  : out(out), buffer(block_size)
+{
+  setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+bool deflate_streambuft::write_block()
+{
+  const std::size_t size = pptr() - pbase();
+  if(size == 0)
+    return false;
+
+  mz_ulong compressed_size = mz_compressBound(size);
+  compressed.resize(compressed_size);
+  if(
+    mz_compress(
+      compressed.data(),
+      &compressed_size,
+      reinterpret_cast<const unsigned char *>(pbase()),
+      size) != MZ_OK)
+  {
+    return true;
+  }
+
+  write_gb_word(out, size);
+  write_gb_word(out, compressed_size);
+  out.write(
+    reinterpret_cast<const char *>(compressed.data()), compressed_size);
+
+  setp(buffer.data(), buffer.data() + buffer.size());
+  return !out;
+}
+
+deflate_streambuft::int_type deflate_streambuft::overflow(int_type ch)
+{
+  if(write_block())
+    return traits_type::eof();
+
+  if(!traits_type::eq_int_type(ch, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+  }
+
+  return traits_type::not_eof(ch);
+}
+
+bool deflate_streambuft::finish()
+{
+  if(write_block())
+    return true;
+
+  write_gb_word(out, 0);
+  return !out;
+}
+
+inflate_streambuft::inflate_streambuft(std::istream &in) : in(in)
+{
+}
+
+inflate_streambuft::int_type inflate_streambuft::underflow()
+{
+  if(gptr() < egptr())
+    return traits_type::to_int_type(*gptr());
+
+  if(at_end)
+    return traits_type::eof();
+
+  // errors end the data, which the reader then reports
+  at_end = true;
+
+  std::size_t size, compressed_size;
+  try
+  {
+    size = irep_serializationt::read_gb_word(in);
+    if(size == 0)
+      return traits_type::eof();
+
+    compressed_size = irep_serializationt::read_gb_word(in);
+  }
+  catch(const deserialization_exceptiont &)
+  {
+    return traits_type::eof();
+  }
+
+  if(size > max_block_size || compressed_size > mz_compressBound(size))
+    return traits_type::eof();
+
+  compressed.resize(compressed_size);
+  if(!in.read(reinterpret_cast<char *>(compressed.data()), compressed_size))
+    return traits_type::eof();
+
+  buffer.resize(size);
+  mz_ulong uncompressed_size = size;
+  if(
+    mz_uncompress(
+      reinterpret_cast<unsigned char *>(buffer.data()),
+      &uncompressed_size,
+      compressed.data(),
+      compressed_size) != MZ_OK ||
+    uncompressed_size != size)
+  {
+    return traits_type::eof();
+  }
+
+  at_end = false;
+  setg(buffer.data(), buffer.data(), buffer.data() + size);
+  return traits_type::to_int_type(*gptr());
+}
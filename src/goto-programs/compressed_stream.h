@@ -0,0 +1,64 @@
+/*******************************************************************\
+
+Module: Block-Compressed Streams
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Stream buffers that compress data in blocks, for goto binaries
+
+#ifndef CPROVER_GOTO_PROGRAMS_COMPRESSED_STREAM_H
+#define CPROVER_GOTO_PROGRAMS_COMPRESSED_STREAM_H
+
+#include <iosfwd>
+#include <streambuf>
+#include <vector>
+
+/// A stream buffer that compresses what is written to it and writes it to the
+/// stream `out`, in blocks. Each block is preceded by its uncompressed and
+/// its compressed size, in the encoding of write_gb_word, and the blocks end
+/// with an uncompressed size of zero.
+class deflate_streambuft : public std::streambuf
+{
+public:
+  explicit deflate_streambuft(std::ostream &out);
+
+  /// Write the remaining data and the end of the blocks; nothing must be
+  /// written to the stream buffer afterwards
+  /// \return true on error
+  bool finish();
+
+protected:
+  int_type overflow(int_type ch) override;
+
+private:
+  std::ostream &out;
+  std::vector<char> buffer;
+  std::vector<unsigned char> compressed;
+
+  /// \return true on error
+  bool write_block();
+};
+
+/// A stream buffer that reads the blocks written by deflate_streambuft from
+/// the stream `in`, one block at a time, and provides their uncompressed
+/// contents. It stops at the end of the blocks, so that whatever follows
+/// them can be read from `in`.
+class inflate_streambuft : public std::streambuf
+{
+public:
+  explicit inflate_streambuft(std::istream &in);
+
+protected:
+  int_type underflow() override;
+
+private:
+  std::istream &in;
+  bool at_end = false;
+  std::vector<char> buffer;
+  std::vector<unsigned char> compressed;
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_COMPRESSED_STREAM_H
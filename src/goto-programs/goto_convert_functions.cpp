@@ -10,6 +10,10 @@ Date: June 2003
 
 #include "goto_convert_functions.h"
 
+#include <unordered_set>
+#include <vector>
+
+#include <util/find_symbols.h>
 #include <util/fresh_symbol.h>
 #include <util/prefix.h>
 #include <util/std_code.h>
@@ -31,6 +35,16 @@ goto_convert_functionst::~goto_convert_functionst()
 {
 }
 
+/// \return true iff \p symbol is a function of a language that goto_convert
+///   handles
+static bool is_function_to_convert(const symbolt &symbol)
+{
+  return !symbol.is_type && !symbol.is_macro && symbol.type.id() == ID_code &&
+         (symbol.mode == ID_C || symbol.mode == ID_cpp ||
+          symbol.mode == ID_java || symbol.mode == "jsil" ||
+          symbol.mode == ID_statement_list);
+}
+
 void goto_convert_functionst::goto_convert(goto_functionst &functions)
 {
   // warning! hash-table iterators are not stable
@@ -40,16 +54,8 @@ void goto_convert_functionst::goto_convert(goto_functionst &functions)
 
   for(const auto &symbol_pair : symbol_table.symbols)
   {
-    if(
-      !symbol_pair.second.is_type && !symbol_pair.second.is_macro &&
-      symbol_pair.second.type.id() == ID_code &&
-      (symbol_pair.second.mode == ID_C || symbol_pair.second.mode == ID_cpp ||
-       symbol_pair.second.mode == ID_java ||
-       symbol_pair.second.mode == "jsil" ||
-       symbol_pair.second.mode == ID_statement_list))
-    {
+    if(is_function_to_convert(symbol_pair.second))
       symbol_list.push_back(symbol_pair.first);
-    }
   }
 
   for(const auto &id : symbol_list)
@@ -73,6 +79,46 @@ void goto_convert_functionst::goto_convert(goto_functionst &functions)
 #endif
 }
 
+void goto_convert_functionst::goto_convert_reachable(
+  goto_functionst &functions,
+  const irep_idt &entry_point)
+{
+  std::vector<irep_idt> queue{entry_point};
+  std::unordered_set<irep_idt> seen{entry_point};
+
+  while(!queue.empty())
+  {
+    const irep_idt identifier = queue.back();
+    queue.pop_back();
+
+    const symbolt *symbol = symbol_table.lookup(identifier);
+    if(symbol == nullptr || !is_function_to_convert(*symbol))
+      continue;
+
+    goto_functionst::goto_functiont &f = functions.function_map[identifier];
+    convert_function(identifier, f);
+
+    // Any function the body mentions may be executed: it is either called
+    // or its address is taken. The body may also have been converted
+    // before, e.g., when it was read from a goto binary.
+    find_symbols_sett mentioned;
+    forall_goto_program_instructions(i_it, f.body)
+    {
+      find_symbols(i_it->code, mentioned, true, false);
+      if(i_it->has_condition())
+        find_symbols(i_it->get_condition(), mentioned, true, false);
+    }
+
+    for(const auto &id : mentioned)
+    {
+      if(seen.insert(id).second)
+        queue.push_back(id);
+    }
+  }
+
+  functions.compute_location_numbers();
+}
+
 bool goto_convert_functionst::hide(const goto_programt &goto_program)
 {
   forall_goto_program_instructions(i_it, goto_program)
@@ -257,6 +303,26 @@ void goto_convert(
   goto_convert_functions.goto_convert(functions);
 }
 
+void goto_convert_reachable(
+  symbol_table_baset &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler)
+{
+  symbol_table_buildert symbol_table_builder =
+    symbol_table_buildert::wrap(symbol_table);
+
+  goto_convert_functionst goto_convert_functions(
+    symbol_table_builder, message_handler);
+
+  if(symbol_table.has_symbol(goto_functionst::entry_point()))
+  {
+    goto_convert_functions.goto_convert_reachable(
+      functions, goto_functionst::entry_point());
+  }
+  else
+    goto_convert_functions.goto_convert(functions);
+}
+
 void goto_convert(
   const irep_idt &identifier,
   symbol_table_baset &symbol_table,
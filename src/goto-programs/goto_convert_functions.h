@@ -29,6 +29,16 @@ void goto_convert(
   goto_modelt &,
   message_handlert &);
 
+/// Convert only the functions that may be executed when running the program
+/// from its entry point, i.e., those that are mentioned (called or their
+/// address taken) in the entry point or in any other function converted this
+/// way. Other functions are neither converted nor added to \p functions.
+/// Converts all functions if there is no entry point.
+void goto_convert_reachable(
+  symbol_table_baset &symbol_table,
+  goto_functionst &functions,
+  message_handlert &);
+
 // just convert a specific function
 void goto_convert(
   const irep_idt &identifier,
@@ -40,6 +50,9 @@ class goto_convert_functionst:public goto_convertt
 {
 public:
   void goto_convert(goto_functionst &functions);
+  void goto_convert_reachable(
+    goto_functionst &functions,
+    const irep_idt &entry_point);
   void convert_function(
     const irep_idt &identifier,
     goto_functionst::goto_functiont &result);
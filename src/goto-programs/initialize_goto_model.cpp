@@ -198,10 +198,18 @@ goto_modelt initialize_goto_model(
 
   msg.status() << "Generating GOTO Program" << messaget::eom;
 
-  goto_convert(
-    goto_model.symbol_table,
-    goto_model.goto_functions,
-    message_handler);
+  if(options.get_bool_option("lazy-functions"))
+  {
+    goto_convert_reachable(
+      goto_model.symbol_table, goto_model.goto_functions, message_handler);
+  }
+  else
+  {
+    goto_convert(
+      goto_model.symbol_table,
+      goto_model.goto_functions,
+      message_handler);
+  }
 
   if(options.is_set("validate-goto-model"))
   {
@@ -1008,16 +1008,23 @@ void interpretert::evaluate(
   {
     const auto &wexpr=to_with_expr(expr);
     evaluate(wexpr.old(), dest);
-    std::vector<mp_integer> where;
-    std::vector<mp_integer> new_value;
-    evaluate(wexpr.where(), where);
-    evaluate(wexpr.new_value(), new_value);
     const auto &subtype=expr.type().subtype();
-    if(!new_value.empty() && where.size()==1 && !unbounded_size(subtype))
+    bool updated=!unbounded_size(subtype);
+
+    // (a WITH [i1:=e1, i2:=e2, ...]) may update several elements
+    for(std::size_t op=1; updated && op+1<expr.operands().size(); op+=2)
     {
+      std::vector<mp_integer> where;
+      std::vector<mp_integer> new_value;
+      evaluate(expr.operands()[op], where);
+      evaluate(expr.operands()[op+1], new_value);
+      updated=!new_value.empty() && where.size()==1;
+      if(!updated)
+        break;
+
       // Ignore indices < 0, which the string solver sometimes produces
       if(where[0]<0)
-        return;
+        continue;
 
       mp_integer where_idx=where[0];
       mp_integer subtype_size=get_size(subtype);
@@ -1029,9 +1036,10 @@ void interpretert::evaluate(
       for(std::size_t i=0; i<new_value.size(); ++i)
         dest[numeric_cast_v<std::size_t>((where_idx * subtype_size) + i)] =
           new_value[i];
+    }
 
+    if(updated)
       return;
-    }
   }
   else if(expr.id()==ID_nil)
   {
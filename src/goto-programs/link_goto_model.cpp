@@ -11,7 +11,16 @@ Author: Michael Tautschnig, Daniel Kroening
 
 #include "link_goto_model.h"
 
+#include <functional>
 #include <unordered_set>
+#include <vector>
+
+#ifdef CPROVER_THREAD_SAFE
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#endif
 
 #include <util/base_type.h>
 #include <util/symbol.h>
@@ -24,7 +33,6 @@ Author: Michael Tautschnig, Daniel Kroening
 
 static void rename_symbols_in_function(
   goto_functionst::goto_functiont &function,
-  irep_idt &new_function_name,
   const rename_symbolt &rename_symbol)
 {
   for(auto &identifier : function.parameter_identifiers)
@@ -50,6 +58,54 @@ static void rename_symbols_in_function(
   }
 }
 
+/// Apply \p f to each of \p functions. When built with CPROVER_THREAD_SAFE,
+/// the functions are processed by as many threads as the hardware supports.
+static void for_each_function(
+  const std::vector<goto_functionst::goto_functiont *> &functions,
+  const std::function<void(goto_functionst::goto_functiont &)> &f)
+{
+#ifdef CPROVER_THREAD_SAFE
+  const std::size_t number_of_threads = std::min<std::size_t>(
+    std::thread::hardware_concurrency(), functions.size());
+
+  if(number_of_threads > 1)
+  {
+    std::atomic<std::size_t> next(0);
+    std::vector<std::exception_ptr> exceptions(number_of_threads);
+    std::vector<std::thread> threads;
+
+    for(auto &exception : exceptions)
+    {
+      threads.emplace_back([&] {
+        try
+        {
+          for(std::size_t i = next++; i < functions.size(); i = next++)
+            f(*functions[i]);
+        }
+        catch(...)
+        {
+          exception = std::current_exception();
+        }
+      });
+    }
+
+    for(auto &thread : threads)
+      thread.join();
+
+    for(const auto &exception : exceptions)
+    {
+      if(exception != nullptr)
+        std::rethrow_exception(exception);
+    }
+  }
+  else
+#endif
+  {
+    for(const auto function : functions)
+      f(*function);
+  }
+}
+
 /// Link a set of goto functions, considering weak symbols
 /// and symbol renaming
 static bool link_functions(
@@ -64,6 +120,9 @@ static bool link_functions(
   namespacet ns(dest_symbol_table);
   namespacet src_ns(src_symbol_table);
 
+  // the functions taken from src, renamed once all are merged
+  std::vector<goto_functionst::goto_functiont *> taken;
+
   // merge functions
   Forall_goto_functions(src_it, src_functions)
   {
@@ -83,8 +142,9 @@ static bool link_functions(
     goto_functionst::goto_functiont &src_func = src_it->second;
     if(dest_f_it==dest_functions.function_map.end()) // not there yet
     {
-      rename_symbols_in_function(src_func, final_id, rename_symbol);
-      dest_functions.function_map.emplace(final_id, std::move(src_func));
+      taken.push_back(
+        &dest_functions.function_map.emplace(final_id, std::move(src_func))
+           .first->second);
     }
     else // collision!
     {
@@ -94,12 +154,11 @@ static bool link_functions(
          weak_symbols.find(final_id)!=weak_symbols.end())
       {
         // the one with body wins!
-        rename_symbols_in_function(src_func, final_id, rename_symbol);
-
         in_dest_symbol_table.body.swap(src_func.body);
         in_dest_symbol_table.parameter_identifiers.swap(
           src_func.parameter_identifiers);
         in_dest_symbol_table.type=src_func.type;
+        taken.push_back(&in_dest_symbol_table);
       }
       else if(src_func.body.instructions.empty() ||
               src_ns.lookup(src_it->first).is_weak)
@@ -120,6 +179,14 @@ static bool link_functions(
     }
   }
 
+  if(!rename_symbol.empty())
+  {
+    for_each_function(
+      taken, [&rename_symbol](goto_functionst::goto_functiont &function) {
+        rename_symbols_in_function(function, rename_symbol);
+      });
+  }
+
   // apply macros
   rename_symbolt macro_application;
 
@@ -146,23 +213,36 @@ static bool link_functions(
     }
   }
 
+  if(macro_application.expr_map.empty() && object_type_updates.empty())
+    return false;
+
+  std::vector<goto_functionst::goto_functiont *> all_functions;
+  all_functions.reserve(dest_functions.function_map.size());
+  Forall_goto_functions(dest_it, dest_functions)
+    all_functions.push_back(&dest_it->second);
+
   if(!macro_application.expr_map.empty())
-    Forall_goto_functions(dest_it, dest_functions)
-    {
-      irep_idt final_id=dest_it->first;
-      rename_symbols_in_function(dest_it->second, final_id, macro_application);
-    }
+  {
+    for_each_function(
+      all_functions,
+      [&macro_application](goto_functionst::goto_functiont &function) {
+        rename_symbols_in_function(function, macro_application);
+      });
+  }
 
   if(!object_type_updates.empty())
   {
-    Forall_goto_functions(dest_it, dest_functions)
-      Forall_goto_program_instructions(iit, dest_it->second.body)
-      {
-        iit->transform([&object_type_updates](exprt expr) {
-          object_type_updates(expr);
-          return expr;
-        });
-      }
+    for_each_function(
+      all_functions,
+      [&object_type_updates](goto_functionst::goto_functiont &function) {
+        Forall_goto_program_instructions(iit, function.body)
+        {
+          iit->transform([&object_type_updates](exprt expr) {
+            object_type_updates(expr);
+            return expr;
+          });
+        }
+      });
   }
 
   return false;
@@ -173,12 +253,14 @@ void link_goto_model(
   goto_modelt &src,
   message_handlert &message_handler)
 {
+  // weak symbols of dest that functions of src may replace
   std::unordered_set<irep_idt> weak_symbols;
 
-  for(const auto &symbol_pair : dest.symbol_table.symbols)
+  for(const auto &function_pair : src.goto_functions.function_map)
   {
-    if(symbol_pair.second.is_weak)
-      weak_symbols.insert(symbol_pair.first);
+    const symbolt *symbol = dest.symbol_table.lookup(function_pair.first);
+    if(symbol != nullptr && symbol->is_weak)
+      weak_symbols.insert(function_pair.first);
   }
 
   linkingt linking(dest.symbol_table,
@@ -18,6 +18,7 @@ Date: June 2006
 #include <util/symbol_table.h>
 #include <util/irep_serialization.h>
 
+#include "compressed_stream.h"
 #include "goto_functions.h"
 #include "write_goto_binary.h"
 
@@ -162,11 +163,8 @@ static bool read_bin_goto_object(
     if(hidden)
     {
       f.make_hidden();
-      // can be removed with the next goto-binary version update as the
-      // information is guaranteed to be stored in the symbol table
-#if GOTO_BINARY_VERSION > 5
-#error This code should be removed
-#endif
+      // binaries of version 5 may not have the information in the symbol
+      // table
       symbol_table.get_writeable_ref(fname).set_hidden();
     }
   }
@@ -232,17 +230,38 @@ bool read_bin_goto_object(
   {
     std::size_t version=irepconverter.read_gb_word(in);
 
-    if(version < GOTO_BINARY_VERSION)
+    if(version < 5)
     {
       message.error() <<
           "The input was compiled with an old version of "
           "goto-cc; please recompile" << messaget::eom;
       return true;
     }
-    else if(version == GOTO_BINARY_VERSION)
+    else if(version == 5)
     {
       return read_bin_goto_object(in, symbol_table, functions, irepconverter);
     }
+    else if(version == GOTO_BINARY_VERSION)
+    {
+      const std::size_t flags = irepconverter.read_gb_word(in);
+
+      if((flags & GOTO_BINARY_COMPRESSED) == 0)
+        return read_bin_goto_object(
+          in, symbol_table, functions, irepconverter);
+
+      inflate_streambuft decompressed_buffer(in);
+      std::istream decompressed_in(&decompressed_buffer);
+      if(read_bin_goto_object(
+           decompressed_in, symbol_table, functions, irepconverter))
+      {
+        return true;
+      }
+
+      // consume the end of the compressed blocks, such that anything that
+      // follows the goto binary can be read from the stream
+      decompressed_in.peek();
+      return !decompressed_in.eof();
+    }
     else
     {
       message.error() <<
@@ -16,12 +16,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/c_types.h>
 #include <util/fresh_symbol.h>
 #include <util/invariant.h>
+#include <util/make_unique.h>
 #include <util/message.h>
 #include <util/pointer_offset_size.h>
 #include <util/replace_expr.h>
 #include <util/source_location.h>
 #include <util/std_expr.h>
 
+#include <analyses/demand_driven_points_to.h>
 #include <analyses/does_remove_const.h>
 
 #include "remove_skip.h"
@@ -36,6 +38,7 @@ public:
     symbol_tablet &_symbol_table,
     bool _add_safety_assertion,
     bool only_resolve_const_fps,
+    bool use_points_to,
     const goto_functionst &goto_functions);
 
   void operator()(goto_functionst &goto_functions);
@@ -74,6 +77,10 @@ protected:
   // --remove-const-function-pointers instead of --remove-function-pointers
   bool only_resolve_const_fps;
 
+  /// Points-to analysis to narrow down the functions that are not found by
+  /// remove_const_function_pointerst, if enabled
+  std::unique_ptr<demand_driven_points_tot> points_to;
+
   /// Replace a call to a dynamic function at location
   /// target in the given goto-program by determining
   /// functions that have a compatible signature
@@ -111,6 +118,7 @@ remove_function_pointerst::remove_function_pointerst(
   symbol_tablet &_symbol_table,
   bool _add_safety_assertion,
   bool only_resolve_const_fps,
+  bool use_points_to,
   const goto_functionst &goto_functions)
   : log(_message_handler),
     ns(_symbol_table),
@@ -118,6 +126,9 @@ remove_function_pointerst::remove_function_pointerst(
     add_safety_assertion(_add_safety_assertion),
     only_resolve_const_fps(only_resolve_const_fps)
 {
+  if(use_points_to)
+    points_to = util_make_unique<demand_driven_points_tot>(goto_functions, ns);
+
   for(const auto &s : symbol_table.symbols)
     compute_address_taken_functions(s.second.value, address_taken);
 
@@ -336,6 +347,12 @@ void remove_function_pointerst::remove_function_pointer(
 
     bool return_value_used=code.lhs().is_not_nil();
 
+    demand_driven_points_tot::sett pointees;
+    if(points_to)
+      pointees = (*points_to)(pointer);
+    else
+      pointees.unknown = true;
+
     // get all type-compatible functions
     // whose address is ever taken
     for(const auto &t : type_map)
@@ -344,6 +361,10 @@ void remove_function_pointerst::remove_function_pointer(
       if(address_taken.find(t.first)==address_taken.end())
         continue;
 
+      // may the pointer point to it?
+      if(!pointees.unknown && pointees.objects.count(t.first) == 0)
+        continue;
+
       // type-compatible?
       if(!is_type_compatible(return_value_used, call_type, t.second))
         continue;
@@ -523,7 +544,8 @@ bool remove_function_pointers(
   goto_programt &goto_program,
   const irep_idt &function_id,
   bool add_safety_assertion,
-  bool only_remove_const_fps)
+  bool only_remove_const_fps,
+  bool use_points_to)
 {
   remove_function_pointerst
     rfp(
@@ -531,6 +553,7 @@ bool remove_function_pointers(
       symbol_table,
       add_safety_assertion,
       only_remove_const_fps,
+      use_points_to,
       goto_functions);
 
   return rfp.remove_function_pointers(goto_program, function_id);
@@ -541,7 +564,8 @@ void remove_function_pointers(
   symbol_tablet &symbol_table,
   goto_functionst &goto_functions,
   bool add_safety_assertion,
-  bool only_remove_const_fps)
+  bool only_remove_const_fps,
+  bool use_points_to)
 {
   remove_function_pointerst
     rfp(
@@ -549,6 +573,7 @@ void remove_function_pointers(
       symbol_table,
       add_safety_assertion,
       only_remove_const_fps,
+      use_points_to,
       goto_functions);
 
   rfp(goto_functions);
@@ -557,12 +582,14 @@ void remove_function_pointers(
 void remove_function_pointers(message_handlert &_message_handler,
   goto_modelt &goto_model,
   bool add_safety_assertion,
-  bool only_remove_const_fps)
+  bool only_remove_const_fps,
+  bool use_points_to)
 {
   remove_function_pointers(
     _message_handler,
     goto_model.symbol_table,
     goto_model.goto_functions,
     add_safety_assertion,
-    only_remove_const_fps);
+    only_remove_const_fps,
+    use_points_to);
 }
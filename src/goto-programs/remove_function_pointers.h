@@ -24,18 +24,22 @@ class symbol_tablet;
 
 // remove indirect function calls
 // and replace by case-split
+// With use_points_to, the targets that would otherwise be chosen by type
+// alone are narrowed down to those a demand-driven points-to analysis finds.
 void remove_function_pointers(
   message_handlert &_message_handler,
   goto_modelt &goto_model,
   bool add_safety_assertion,
-  bool only_remove_const_fps=false);
+  bool only_remove_const_fps=false,
+  bool use_points_to = false);
 
 void remove_function_pointers(
   message_handlert &_message_handler,
   symbol_tablet &symbol_table,
   goto_functionst &goto_functions,
   bool add_safety_assertion,
-  bool only_remove_const_fps=false);
+  bool only_remove_const_fps=false,
+  bool use_points_to = false);
 
 bool remove_function_pointers(
   message_handlert &_message_handler,
@@ -44,6 +48,7 @@ bool remove_function_pointers(
   goto_programt &goto_program,
   const irep_idt &function_id,
   bool add_safety_assertion,
-  bool only_remove_const_fps = false);
+  bool only_remove_const_fps = false,
+  bool use_points_to = false);
 
 #endif // CPROVER_GOTO_PROGRAMS_REMOVE_FUNCTION_POINTERS_H
@@ -21,6 +21,8 @@ Author: CM Wintersteiger
 
 #include <goto-programs/goto_model.h>
 
+#include "compressed_stream.h"
+
 /// Writes a goto program to disc, using goto binary format
 bool write_goto_binary(
   std::ostream &out,
@@ -125,13 +127,15 @@ bool write_goto_binary(
 bool write_goto_binary(
   std::ostream &out,
   const goto_modelt &goto_model,
-  int version)
+  int version,
+  bool compress)
 {
   return write_goto_binary(
     out,
     goto_model.symbol_table,
     goto_model.goto_functions,
-    version);
+    version,
+    compress);
 }
 
 /// Writes a goto program to disc
@@ -139,7 +143,8 @@ bool write_goto_binary(
   std::ostream &out,
   const symbol_tablet &symbol_table,
   const goto_functionst &goto_functions,
-  int version)
+  int version,
+  bool compress)
 {
   // header
   out << char(0x7f) << "GBF";
@@ -156,8 +161,17 @@ bool write_goto_binary(
     throw invalid_command_line_argument_exceptiont(
       "unknown goto binary version " + std::to_string(version),
       "supported version = " + std::to_string(GOTO_BINARY_VERSION));
-  else
+
+  write_gb_word(out, compress ? GOTO_BINARY_COMPRESSED : 0);
+
+  if(!compress)
     return write_goto_binary(out, symbol_table, goto_functions, irepconverter);
+
+  deflate_streambuft compressed_buffer(out);
+  std::ostream compressed_out(&compressed_buffer);
+  return write_goto_binary(
+           compressed_out, symbol_table, goto_functions, irepconverter) ||
+         !compressed_out || compressed_buffer.finish();
 }
 
 /// Writes a goto program to disc
@@ -12,7 +12,11 @@ Author: CM Wintersteiger
 #ifndef CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H
 #define CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H
 
-#define GOTO_BINARY_VERSION 5
+#define GOTO_BINARY_VERSION 6
+
+/// Flag in the header of goto binaries, from version 6 on, that is set if
+/// the rest of the file is compressed in blocks, see deflate_streambuft
+#define GOTO_BINARY_COMPRESSED 1
 
 #include <iosfwd>
 #include <string>
@@ -25,13 +29,15 @@ class message_handlert;
 bool write_goto_binary(
   std::ostream &out,
   const goto_modelt &,
-  int version=GOTO_BINARY_VERSION);
+  int version=GOTO_BINARY_VERSION,
+  bool compress=false);
 
 bool write_goto_binary(
   std::ostream &out,
   const symbol_tablet &,
   const goto_functionst &,
-  int version=GOTO_BINARY_VERSION);
+  int version=GOTO_BINARY_VERSION,
+  bool compress=false);
 
 bool write_goto_binary(
   const std::string &filename,
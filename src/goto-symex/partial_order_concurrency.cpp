@@ -31,7 +31,9 @@ void partial_order_concurrencyt::add_init_writes(
   std::unordered_set<irep_idt> init_done;
   bool spawn_seen=false;
 
-  symex_target_equationt::SSA_stepst init_steps;
+  // share the pool of the equation, to splice the steps into it
+  symex_target_equationt::SSA_stepst init_steps(
+    equation.SSA_steps.get_allocator());
 
   for(eventst::const_iterator
       e_it=equation.SSA_steps.begin();
@@ -133,7 +133,7 @@ show_vcc_json(std::ostream &out, const symex_target_equationt &equation)
     if(source_location.is_not_nil())
       object["sourceLocation"] = json(source_location);
 
-    const std::string &s = s_it->comment;
+    const std::string &s = id2string(s_it->comment);
     if(!s.empty())
       object["comment"] = json_stringt(s);
 
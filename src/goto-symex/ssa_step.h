@@ -131,9 +131,38 @@ public:
   /// builds a unique name for an unwinding assertion.
   irep_idt get_property_id() const;
 
+  // Equations may consist of tens of millions of steps. The members are thus
+  // ordered to avoid padding: flags and enumerations come first, followed by
+  // pointer-sized and then by larger members.
+
+  // for ASSIGNMENT and DECL
+  symex_targett::assignment_typet assignment_type;
+
+  // for SHARED_READ/SHARED_WRITE and ATOMIC_BEGIN/ATOMIC_END
+  unsigned atomic_section_id = 0;
+
   // we may choose to hide
   bool hidden = false;
 
+  // for INPUT/OUTPUT
+  bool formatted = false;
+
+  // for slicing
+  bool ignore = false;
+
+  // for incremental conversion
+  bool converted = false;
+
+  // for ASSUME/ASSERT/GOTO/CONSTRAINT; interned, as a property's message is
+  // shared by all of its instances
+  irep_idt comment;
+
+  // for INPUT/OUTPUT
+  irep_idt format_string, io_id;
+
+  // for function calls: the function that is called
+  irep_idt called_function;
+
   exprt guard;
   exprt guard_handle;
 
@@ -141,52 +170,36 @@ public:
   ssa_exprt ssa_lhs;
   exprt ssa_full_lhs, original_full_lhs;
   exprt ssa_rhs;
-  symex_targett::assignment_typet assignment_type;
 
   // for ASSUME/ASSERT/GOTO/CONSTRAINT
   exprt cond_expr;
   exprt cond_handle;
-  std::string comment;
 
   // for INPUT/OUTPUT
-  irep_idt format_string, io_id;
-  bool formatted = false;
   std::list<exprt> io_args;
   std::list<exprt> converted_io_args;
 
-  // for function calls: the function that is called
-  irep_idt called_function;
-
   // for function calls
   std::vector<exprt> ssa_function_arguments, converted_function_arguments;
 
-  // for SHARED_READ/SHARED_WRITE and ATOMIC_BEGIN/ATOMIC_END
-  unsigned atomic_section_id = 0;
-
-  // for slicing
-  bool ignore = false;
-
-  // for incremental conversion
-  bool converted = false;
-
   SSA_stept(
     const symex_targett::sourcet &_source,
     goto_trace_stept::typet _type)
     : source(_source),
       type(_type),
+      assignment_type(symex_targett::assignment_typet::STATE),
+      atomic_section_id(0),
       hidden(false),
+      formatted(false),
+      ignore(false),
       guard(static_cast<const exprt &>(get_nil_irep())),
       guard_handle(false_exprt()),
       ssa_lhs(static_cast<const ssa_exprt &>(get_nil_irep())),
       ssa_full_lhs(static_cast<const exprt &>(get_nil_irep())),
       original_full_lhs(static_cast<const exprt &>(get_nil_irep())),
       ssa_rhs(static_cast<const exprt &>(get_nil_irep())),
-      assignment_type(symex_targett::assignment_typet::STATE),
       cond_expr(static_cast<const exprt &>(get_nil_irep())),
-      cond_handle(false_exprt()),
-      formatted(false),
-      atomic_section_id(0),
-      ignore(false)
+      cond_handle(false_exprt())
   {
   }
 
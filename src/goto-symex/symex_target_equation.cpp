@@ -539,27 +539,32 @@ void symex_target_equationt::convert_function_calls(
 {
   for(auto &step : SSA_steps)
     if(!step.ignore)
+      convert_function_call(step, dec_proc);
+}
+
+void symex_target_equationt::convert_function_call(
+  SSA_stept &step,
+  decision_proceduret &dec_proc)
+{
+  step.converted_function_arguments.reserve(step.ssa_function_arguments.size());
+
+  for(const auto &arg : step.ssa_function_arguments)
+  {
+    if(arg.is_constant() ||
+       arg.id()==ID_string_constant)
+      step.converted_function_arguments.push_back(arg);
+    else
     {
-      step.converted_function_arguments.reserve(step.ssa_function_arguments.size());
+      const irep_idt identifier="symex::args::"+std::to_string(argument_count++);
+      symbol_exprt symbol(identifier, arg.type());
 
-      for(const auto &arg : step.ssa_function_arguments)
-      {
-        if(arg.is_constant() ||
-           arg.id()==ID_string_constant)
-          step.converted_function_arguments.push_back(arg);
-        else
-        {
-          const irep_idt identifier="symex::args::"+std::to_string(argument_count++);
-          symbol_exprt symbol(identifier, arg.type());
-
-          equal_exprt eq(arg, symbol);
-          merge_irep(eq);
-
-          dec_proc.set_to(eq, true);
-          step.converted_function_arguments.push_back(symbol);
-        }
-      }
+      equal_exprt eq(arg, symbol);
+      merge_irep(eq);
+
+      dec_proc.set_to(eq, true);
+      step.converted_function_arguments.push_back(symbol);
     }
+  }
 }
 
 void symex_target_equationt::convert_io(
@@ -567,26 +572,102 @@ void symex_target_equationt::convert_io(
 {
   for(auto &step : SSA_steps)
     if(!step.ignore)
+      convert_io(step, dec_proc);
+}
+
+void symex_target_equationt::convert_io(
+  SSA_stept &step,
+  decision_proceduret &dec_proc)
+{
+  for(const auto &arg : step.io_args)
+  {
+    if(arg.is_constant() ||
+       arg.id()==ID_string_constant)
+      step.converted_io_args.push_back(arg);
+    else
     {
-      for(const auto &arg : step.io_args)
-      {
-        if(arg.is_constant() ||
-           arg.id()==ID_string_constant)
-          step.converted_io_args.push_back(arg);
-        else
-        {
-          const irep_idt identifier =
-            "symex::io::" + std::to_string(io_count++);
-          symbol_exprt symbol(identifier, arg.type());
-
-          equal_exprt eq(arg, symbol);
-          merge_irep(eq);
-
-          dec_proc.set_to(eq, true);
-          step.converted_io_args.push_back(symbol);
-        }
-      }
+      const irep_idt identifier =
+        "symex::io::" + std::to_string(io_count++);
+      symbol_exprt symbol(identifier, arg.type());
+
+      equal_exprt eq(arg, symbol);
+      merge_irep(eq);
+
+      dec_proc.set_to(eq, true);
+      step.converted_io_args.push_back(symbol);
     }
+  }
+}
+
+void symex_target_equationt::convert_new_steps(
+  decision_proceduret &decision_procedure)
+{
+  PRECONDITION(number_of_converted_steps <= SSA_steps.size());
+
+  // walk back from the end, so that the cost is linear in the number of new
+  // steps rather than in the size of the equation
+  SSA_stepst::iterator it = SSA_steps.end();
+  for(std::size_t new_steps = SSA_steps.size() - number_of_converted_steps;
+      new_steps != 0;
+      --new_steps)
+  {
+    --it;
+  }
+
+  for(; it != SSA_steps.end(); ++it)
+    convert_step(*it, decision_procedure);
+
+  number_of_converted_steps = SSA_steps.size();
+}
+
+void symex_target_equationt::convert_step(
+  SSA_stept &step,
+  decision_proceduret &decision_procedure)
+{
+  if(step.ignore)
+  {
+    step.guard_handle = false_exprt();
+    if(step.is_assume() || step.is_goto())
+      step.cond_handle = true_exprt();
+    return;
+  }
+
+  log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
+    step.output(mstream);
+    mstream << messaget::eom;
+  });
+
+  step.guard_handle = decision_procedure.handle(step.guard);
+
+  if((step.is_assignment() || step.is_constraint()) && !step.converted)
+  {
+    decision_procedure.set_to_true(step.cond_expr);
+    step.converted = true;
+  }
+  else if(step.is_decl() && !step.converted)
+  {
+    // The result is not used, these have no impact on
+    // the satisfiability of the formula.
+    decision_procedure.handle(step.cond_expr);
+    step.converted = true;
+  }
+  else if(step.is_assume() || step.is_goto())
+    step.cond_handle = decision_procedure.handle(step.cond_expr);
+
+  convert_function_call(step, decision_procedure);
+  convert_io(step, decision_procedure);
+
+  // Release what neither convert_assertions nor build_goto_trace use. The
+  // guard is replaced by its handle, which is equivalent, but small.
+  if(!step.is_assert() && !step.is_assume())
+  {
+    step.guard = step.guard_handle;
+    if(!step.is_goto())
+      step.cond_expr.make_nil();
+  }
+  step.ssa_function_arguments.clear();
+  step.ssa_function_arguments.shrink_to_fit();
+  step.io_args.clear();
 }
 
 /// Merging causes identical ireps to be shared.
@@ -20,6 +20,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/merge_irep.h>
 #include <util/message.h>
 #include <util/narrow.h>
+#include <util/pool_allocator.h>
 
 #include <goto-programs/goto_program.h>
 #include <goto-programs/goto_trace.h>
@@ -233,6 +234,16 @@ public:
   /// \param decision_procedure: A handle to a decision procedure interface
   void convert_io(decision_proceduret &decision_procedure);
 
+  /// Converts the steps that have been added since the previous call (all
+  /// steps on the first call), except for assertions, which are left to
+  /// \ref convert_assertions or a property decider. Once a step has been
+  /// converted, those of its expressions that are needed neither for further
+  /// conversion nor for building traces are released. This permits passing
+  /// the equation to the decision procedure while symex is still producing it,
+  /// provided steps are only ever appended and the equation is not sliced.
+  /// \param decision_procedure: A handle to a decision procedure interface
+  void convert_new_steps(decision_proceduret &decision_procedure);
+
   exprt make_expression() const;
 
   std::size_t count_assertions() const
@@ -251,7 +262,10 @@ public:
       }));
   }
 
-  typedef std::list<SSA_stept> SSA_stepst;
+  /// Steps are allocated from a pool that the equation, and any copies of
+  /// it, own: equations may have tens of millions of steps, which are rarely
+  /// released before the equation is.
+  typedef std::list<SSA_stept, pool_allocatort<SSA_stept>> SSA_stepst;
   SSA_stepst SSA_steps;
 
   SSA_stepst::iterator get_SSA_step(std::size_t s)
@@ -270,6 +284,7 @@ public:
   void clear()
   {
     SSA_steps.clear();
+    number_of_converted_steps = 0;
   }
 
   bool has_threads() const
@@ -298,6 +313,15 @@ protected:
 
   // for unique function call argument identifiers
   std::size_t argument_count = 0;
+
+  // for convert_new_steps: the length of the prefix of SSA_steps that has
+  // been converted already
+  std::size_t number_of_converted_steps = 0;
+
+  void convert_step(SSA_stept &step, decision_proceduret &decision_procedure);
+  void
+  convert_function_call(SSA_stept &step, decision_proceduret &dec_proc);
+  void convert_io(SSA_stept &step, decision_proceduret &dec_proc);
 };
 
 inline bool operator<(
@@ -62,6 +62,16 @@ public:
     std::istream &instream,
     const std::string &path)=0;
 
+  /// Parse \p instream, which holds the output of \ref preprocess for the
+  /// file \p path, without preprocessing it again. Languages that do not
+  /// preprocess their input parse \p instream as it is.
+  /// \return true on error, false otherwise
+  virtual bool
+  parse_preprocessed(std::istream &instream, const std::string &path)
+  {
+    return parse(instream, path);
+  }
+
   /// Create language-specific support functions, such as __CPROVER_start,
   /// __CPROVER_initialize and language-specific library functions.
   /// This runs after the `typecheck` phase but before lazy function loading.
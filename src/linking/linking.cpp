@@ -1212,7 +1212,10 @@ bool linkingt::needs_renaming_type(
     return true;
 
   if(old_symbol.type==new_symbol.type)
+  {
+    identical_type_symbols.insert(new_symbol.name);
     return false;
+  }
 
   if(
     old_symbol.type.id() == ID_struct &&
@@ -1264,6 +1267,9 @@ void linkingt::do_type_dependencies(
   // Any type that uses a symbol that will be renamed also
   // needs to be renamed, and so on, until saturation.
 
+  if(needs_to_be_renamed.empty())
+    return;
+
   used_byt used_by;
 
   for(const auto &symbol_pair : src_symbol_table.symbols)
@@ -1339,6 +1345,10 @@ void linkingt::copy_symbols()
   // First apply the renaming
   for(const auto &named_symbol : src_symbol_table.symbols)
   {
+    // nothing to do, the main table has the same type already
+    if(identical_type_symbols.count(named_symbol.first) != 0)
+      continue;
+
     symbolt symbol=named_symbol.second;
     // apply the renaming
     rename_symbol(symbol.type);
@@ -1383,6 +1393,9 @@ void linkingt::copy_symbols()
   }
 
   // Apply type updates to initializers
+  if(object_type_updates.empty())
+    return;
+
   for(const auto &named_symbol : main_symbol_table.symbols)
   {
     if(!named_symbol.second.is_type &&
@@ -1424,6 +1437,11 @@ void linkingt::typecheck()
   // renaming types may trigger further renaming
   do_type_dependencies(needs_to_be_renamed);
 
+  // a type that is the same as in the main table but refers to a renamed
+  // type means something different
+  for(const irep_idt &id : needs_to_be_renamed)
+    identical_type_symbols.erase(id);
+
   // PHASE 2: actually rename them
   rename_symbols(needs_to_be_renamed);
 
@@ -179,6 +179,11 @@ protected:
 
   // the new IDs created by renaming
   std::unordered_set<irep_idt> renamed_ids;
+
+  /// Type symbols of the source table whose type is the same as that of the
+  /// type symbol of the same name in the main table. These are neither
+  /// renamed nor copied, and the (costly) type comparison is done once.
+  std::unordered_set<irep_idt> identical_type_symbols;
 };
 
 #endif // CPROVER_LINKING_LINKING_CLASS_H
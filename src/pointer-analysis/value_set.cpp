@@ -862,15 +862,21 @@ void value_sett::get_value_set_rec(
       // the new value might be interesting.
 
       get_value_set_rec(with_expr.old(), dest, suffix, original_type, ns);
-      get_value_set_rec(
-        with_expr.new_value(), dest, new_value_suffix, original_type, ns);
+
+      // (a WITH [i1:=e1, i2:=e2, ...]) may update several elements
+      for(std::size_t i = 2; i < expr.operands().size(); i += 2)
+      {
+        get_value_set_rec(
+          expr.operands()[i], dest, new_value_suffix, original_type, ns);
+      }
     }
     else
     {
       // Something else-- the suffixes used here are a rough guess at best,
       // so this is imprecise.
       get_value_set_rec(with_expr.old(), dest, suffix, original_type, ns);
-      get_value_set_rec(with_expr.new_value(), dest, "", original_type, ns);
+      for(std::size_t i = 2; i < expr.operands().size(); i += 2)
+        get_value_set_rec(expr.operands()[i], dest, "", original_type, ns);
     }
   }
   else if(expr.id()==ID_array)
@@ -1309,8 +1315,10 @@ void value_sett::assign(
           type.subtype());
 
         assign(lhs_index, op0_index, ns, is_simplified, add_to_sets);
-        assign(
-          lhs_index, to_with_expr(rhs).new_value(), ns, is_simplified, true);
+
+        // (a WITH [i1:=e1, i2:=e2, ...]) may update several elements
+        for(std::size_t i = 2; i < rhs.operands().size(); i += 2)
+          assign(lhs_index, rhs.operands()[i], ns, is_simplified, true);
       }
       else
       {
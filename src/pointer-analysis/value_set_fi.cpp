@@ -1091,7 +1091,10 @@ void value_set_fit::assign(
           type.subtype());
 
         assign(lhs_index, op0_index, ns);
-        assign(lhs_index, to_with_expr(rhs).new_value(), ns);
+
+        // (a WITH [i1:=e1, i2:=e2, ...]) may update several elements
+        for(std::size_t i = 2; i < rhs.operands().size(); i += 2)
+          assign(lhs_index, rhs.operands()[i], ns);
       }
       else
       {
@@ -0,0 +1,223 @@
+/*******************************************************************\
+
+Module: Dense Bit Vectors
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Sets of small non-negative integers represented as bit vectors
+
+#ifndef CPROVER_UTIL_DENSE_BITVECTOR_H
+#define CPROVER_UTIL_DENSE_BITVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+/// A set of small non-negative integers, such as densely numbered definitions
+/// in a gen/kill data-flow analysis, stored as one bit per possible element.
+/// Union and difference process a whole machine word at a time and are
+/// simple loops over arrays that compilers can vectorise. The vector never
+/// ends in a zero word, so equality and emptiness are cheap.
+class dense_bitvectort
+{
+public:
+  typedef std::uint64_t wordt;
+  static const std::size_t word_bits = 64;
+
+  bool empty() const
+  {
+    return words.empty();
+  }
+
+  void clear()
+  {
+    words.clear();
+  }
+
+  bool contains(std::size_t i) const
+  {
+    const std::size_t w = i / word_bits;
+    return w < words.size() && (words[w] & bit(i)) != 0;
+  }
+
+  /// \return true iff \p i was not in the set before
+  bool insert(std::size_t i)
+  {
+    const std::size_t w = i / word_bits;
+    if(w >= words.size())
+      words.resize(w + 1, 0);
+    else if((words[w] & bit(i)) != 0)
+      return false;
+
+    words[w] |= bit(i);
+    return true;
+  }
+
+  /// \return true iff \p i was in the set before
+  bool erase(std::size_t i)
+  {
+    if(!contains(i))
+      return false;
+
+    words[i / word_bits] &= ~bit(i);
+    trim();
+    return true;
+  }
+
+  /// Add all elements of \p other to this set
+  /// \return true iff this set has changed
+  bool union_with(const dense_bitvectort &other)
+  {
+    if(other.words.size() > words.size())
+      words.resize(other.words.size(), 0);
+
+    wordt changed = 0;
+    for(std::size_t w = 0; w < other.words.size(); ++w)
+    {
+      const wordt new_word = words[w] | other.words[w];
+      changed |= new_word ^ words[w];
+      words[w] = new_word;
+    }
+
+    return changed != 0;
+  }
+
+  /// Remove all elements of \p other from this set
+  void subtract(const dense_bitvectort &other)
+  {
+    const std::size_t common =
+      words.size() < other.words.size() ? words.size() : other.words.size();
+
+    for(std::size_t w = 0; w < common; ++w)
+      words[w] &= ~other.words[w];
+
+    trim();
+  }
+
+  bool operator==(const dense_bitvectort &other) const
+  {
+    return words == other.words;
+  }
+
+  bool operator!=(const dense_bitvectort &other) const
+  {
+    return words != other.words;
+  }
+
+  /// Iterates over the elements of the set in increasing order
+  class const_iteratort
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::size_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const std::size_t *pointer;
+    typedef const std::size_t &reference;
+
+    reference operator*() const
+    {
+      return current;
+    }
+
+    const_iteratort &operator++()
+    {
+      // clear the bit just visited and find the next one
+      remaining &= remaining - 1;
+      advance();
+      return *this;
+    }
+
+    const_iteratort operator++(int)
+    {
+      const_iteratort tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const const_iteratort &other) const
+    {
+      return word == other.word && remaining == other.remaining;
+    }
+
+    bool operator!=(const const_iteratort &other) const
+    {
+      return !(*this == other);
+    }
+
+  private:
+    friend class dense_bitvectort;
+
+    const_iteratort(const std::vector<wordt> &words, std::size_t word)
+      : words(&words),
+        word(word),
+        remaining(word < words.size() ? words[word] : 0),
+        current(0)
+    {
+      advance();
+    }
+
+    void advance()
+    {
+      while(remaining == 0)
+      {
+        if(word >= words->size())
+          return;
+        ++word;
+        if(word == words->size())
+          return;
+        remaining = (*words)[word];
+      }
+
+      current = word * word_bits + count_trailing_zeros(remaining);
+    }
+
+    const std::vector<wordt> *words;
+    std::size_t word;
+    wordt remaining;
+    std::size_t current;
+  };
+
+  typedef const_iteratort const_iterator;
+
+  const_iteratort begin() const
+  {
+    return const_iteratort(words, 0);
+  }
+
+  const_iteratort end() const
+  {
+    return const_iteratort(words, words.size());
+  }
+
+private:
+  std::vector<wordt> words;
+
+  static wordt bit(std::size_t i)
+  {
+    return wordt(1) << (i % word_bits);
+  }
+
+  void trim()
+  {
+    while(!words.empty() && words.back() == 0)
+      words.pop_back();
+  }
+
+  static std::size_t count_trailing_zeros(wordt w)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(w));
+#else
+    std::size_t n = 0;
+    for(; (w & 1) == 0; w >>= 1)
+      ++n;
+    return n;
+#endif
+  }
+};
+
+#endif // CPROVER_UTIL_DENSE_BITVECTOR_H
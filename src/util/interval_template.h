@@ -143,6 +143,28 @@ public:
     }
   }
 
+  /// Join with \p i, but drop every bound that \p i exceeds, such that
+  /// repeated widening reaches a fixed point after at most two steps
+  /// \return true if the interval has changed
+  bool widen_with(const interval_templatet &i)
+  {
+    bool changed = false;
+
+    if(lower_set && (!i.lower_set || i.lower < lower))
+    {
+      lower_set = false;
+      changed = true;
+    }
+
+    if(upper_set && (!i.upper_set || upper < i.upper))
+    {
+      upper_set = false;
+      changed = true;
+    }
+
+    return changed;
+  }
+
   void approx_union_with(const interval_templatet &i)
   {
     if(i.lower_set && lower_set)
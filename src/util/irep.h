@@ -13,12 +13,22 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <string>
 #include <vector>
 
+#ifdef CPROVER_THREAD_SAFE
+#include <atomic>
+#endif
+
 #include "invariant.h"
 #include "irep_ids.h"
 
 #define SHARING
 #ifndef HASH_CODE
-#  define HASH_CODE 1
+// Caching hash codes in shared nodes would be a data race when ireps are
+// hashed concurrently, hence the thread-safe build does not do so by default.
+#  ifdef CPROVER_THREAD_SAFE
+#    define HASH_CODE 0
+#  else
+#    define HASH_CODE 1
+#  endif
 #endif
 // #define NAMED_SUB_IS_FORWARD_LIST
 
@@ -90,11 +100,33 @@ struct ref_count_ift
 {
 };
 
+#ifndef CPROVER_THREAD_SAFE
 template <>
 struct ref_count_ift<true>
 {
   unsigned ref_count = 1;
 };
+#else
+/// With `CPROVER_THREAD_SAFE` the reference count is atomic, so that ireps
+/// sharing nodes can be copied and destroyed by different threads. A copy of a
+/// node is a fresh node, and hence starts with a count of one.
+template <>
+struct ref_count_ift<true>
+{
+  std::atomic<unsigned> ref_count{1};
+
+  ref_count_ift() = default;
+
+  ref_count_ift(const ref_count_ift &)
+  {
+  }
+
+  ref_count_ift &operator=(const ref_count_ift &)
+  {
+    return *this;
+  }
+};
+#endif
 
 /// A node with data in a tree, it contains:
 ///
@@ -586,8 +618,9 @@ void sharing_treet<derivedt, named_subtreest>::remove_ref(dt *old_data)
   std::cout << "R: " << old_data << " " << old_data->ref_count << '\n';
 #endif
 
-  old_data->ref_count--;
-  if(old_data->ref_count == 0)
+  // decrement and test in one step, which the atomic counter of the
+  // thread-safe build requires
+  if(--old_data->ref_count == 0)
   {
 #ifdef IREP_DEBUG
     std::cout << "D: " << pretty() << '\n';
@@ -622,9 +655,7 @@ void sharing_treet<derivedt, named_subtreest>::nonrecursive_destructor(
       continue;
 
     INVARIANT(d->ref_count != 0, "All contents of the stack must be in use");
-    d->ref_count--;
-
-    if(d->ref_count == 0)
+    if(--d->ref_count == 0)
     {
       stack.reserve(
         stack.size() + std::distance(d->named_sub.begin(), d->named_sub.end()) +
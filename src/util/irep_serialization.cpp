@@ -120,12 +120,20 @@ void irep_serializationt::reference_convert(
 {
   std::size_t h=ireps_container.irep_full_hash_container.number(irep);
 
-  const auto res = ireps_container.ireps_on_write.insert(
-    {h, ireps_container.ireps_on_write.size()});
+  if(h >= ireps_container.ireps_on_write.size())
+    ireps_container.ireps_on_write.resize(h + 1, 0);
 
-  write_gb_word(out, res.first->second);
-  if(res.second)
+  const std::size_t number = ireps_container.ireps_on_write[h];
+
+  if(number != 0)
+    write_gb_word(out, number - 1);
+  else
+  {
+    // number it before its operands, which the reader expects
+    write_gb_word(out, ireps_container.ireps_written);
+    ireps_container.ireps_on_write[h] = ++ireps_container.ireps_written;
     write_irep(out, irep);
+  }
 }
 
 /// Write 7 bits of `u` each time, least-significant byte first, until we have
@@ -227,14 +235,16 @@ void irep_serializationt::write_string_ref(
 {
   size_t id=irep_id_hash()(s);
   if(id>=ireps_container.string_map.size())
-    ireps_container.string_map.resize(id+1, false);
+    ireps_container.string_map.resize(id+1, 0);
+
+  const std::size_t number = ireps_container.string_map[id];
 
-  if(ireps_container.string_map[id])
-    write_gb_word(out, id);
+  if(number != 0)
+    write_gb_word(out, number - 1);
   else
   {
-    ireps_container.string_map[id]=true;
-    write_gb_word(out, id);
+    write_gb_word(out, ireps_container.strings_written);
+    ireps_container.string_map[id] = ++ireps_container.strings_written;
     write_gb_string(out, id2string(s));
   }
 }
@@ -35,11 +35,18 @@ public:
     ireps_on_readt ireps_on_read;
 
     irep_full_hash_containert irep_full_hash_container;
-    typedef std::map<std::size_t, std::size_t> ireps_on_writet;
+    /// One more than the number of each written irep, by the number that
+    /// irep_full_hash_container gives it; 0 if not written yet
+    typedef std::vector<std::size_t> ireps_on_writet;
     ireps_on_writet ireps_on_write;
+    std::size_t ireps_written = 0;
 
-    typedef std::vector<bool> string_mapt;
+    /// One more than the number of each written string, by its number in the
+    /// string container; 0 if not written yet. Strings are numbered in the
+    /// order they are written, so that references to them are small.
+    typedef std::vector<std::size_t> string_mapt;
     string_mapt string_map;
+    std::size_t strings_written = 0;
 
     typedef std::vector<std::pair<bool, irep_idt> > string_rev_mapt;
     string_rev_mapt string_rev_map;
@@ -48,8 +55,10 @@ public:
     {
       irep_full_hash_container.clear();
       ireps_on_write.clear();
+      ireps_written = 0;
       ireps_on_read.clear();
       string_map.clear();
+      strings_written = 0;
       string_rev_map.clear();
     }
   };
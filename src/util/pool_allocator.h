@@ -0,0 +1,193 @@
+/*******************************************************************\
+
+Module: Pool allocator
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Pool allocator
+
+#ifndef CPROVER_UTIL_POOL_ALLOCATOR_H
+#define CPROVER_UTIL_POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#ifdef CPROVER_THREAD_SAFE
+#include <mutex>
+#endif
+
+/// Storage for small objects, obtained from the system in chunks of many
+/// objects at a time. Released objects are kept on a free list per object
+/// size for reuse; chunks are only returned when the pool is destroyed. This
+/// avoids the per-allocation overhead of the system allocator and keeps
+/// objects allocated one after another close to each other in memory.
+class memory_poolt
+{
+public:
+  memory_poolt() = default;
+  memory_poolt(const memory_poolt &) = delete;
+  memory_poolt &operator=(const memory_poolt &) = delete;
+
+  ~memory_poolt()
+  {
+    for(const auto &size_class : size_classes)
+      for(void *chunk : size_class.chunks)
+        ::operator delete(chunk);
+  }
+
+  void *allocate(std::size_t size)
+  {
+#ifdef CPROVER_THREAD_SAFE
+    std::lock_guard<std::mutex> lock(mutex);
+#endif
+
+    size_classt &size_class = get_size_class(size);
+
+    if(size_class.free_list != nullptr)
+    {
+      void *object = size_class.free_list;
+      size_class.free_list = *static_cast<void **>(object);
+      return object;
+    }
+
+    if(size_class.unused_in_chunk == 0)
+    {
+      size_class.chunks.push_back(
+        ::operator new(size_class.slot_size * size_class.objects_per_chunk));
+      size_class.unused_in_chunk = size_class.objects_per_chunk;
+    }
+
+    --size_class.unused_in_chunk;
+    return static_cast<char *>(size_class.chunks.back()) +
+           size_class.unused_in_chunk * size_class.slot_size;
+  }
+
+  void deallocate(void *object, std::size_t size)
+  {
+#ifdef CPROVER_THREAD_SAFE
+    std::lock_guard<std::mutex> lock(mutex);
+#endif
+
+    size_classt &size_class = get_size_class(size);
+    *static_cast<void **>(object) = size_class.free_list;
+    size_class.free_list = object;
+  }
+
+private:
+  struct size_classt
+  {
+    std::size_t slot_size;
+    std::size_t objects_per_chunk;
+    std::vector<void *> chunks;
+    std::size_t unused_in_chunk;
+    void *free_list;
+  };
+
+  /// Containers allocate objects of one or two sizes only
+  std::vector<size_classt> size_classes;
+
+#ifdef CPROVER_THREAD_SAFE
+  std::mutex mutex;
+#endif
+
+  size_classt &get_size_class(std::size_t size)
+  {
+    // slots are suitably aligned for any type and can hold the free list
+    const std::size_t alignment = alignof(std::max_align_t);
+    if(size < sizeof(void *))
+      size = sizeof(void *);
+    const std::size_t slot_size =
+      (size + alignment - 1) / alignment * alignment;
+
+    for(auto &size_class : size_classes)
+    {
+      if(size_class.slot_size == slot_size)
+        return size_class;
+    }
+
+    // chunks of about 64 KiB, but at least 16 objects
+    const std::size_t objects_per_chunk =
+      slot_size * 16 > 65536 ? 16 : 65536 / slot_size;
+    size_classes.push_back({slot_size, objects_per_chunk, {}, 0, nullptr});
+    return size_classes.back();
+  }
+};
+
+/// Allocator for containers that allocate one element at a time, such as
+/// `std::list`, `std::set` or `std::map`: single objects come from a
+/// memory_poolt, requests for several objects are passed on to
+/// `operator new`.
+/// The pool is owned by the allocators that use it: a default-constructed
+/// allocator creates a new pool, and copies, including those the containers
+/// make, share it. The pool is thus released with the last container that
+/// uses it. Allocators compare equal if they share the pool; to splice lists,
+/// construct one with the allocator of the other.
+template <typename T>
+class pool_allocatort
+{
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  static_assert(
+    alignof(T) <= alignof(std::max_align_t),
+    "pool objects are aligned for fundamental types only");
+
+  pool_allocatort() : pool(std::make_shared<memory_poolt>())
+  {
+  }
+
+  template <typename U>
+  // NOLINTNEXTLINE(runtime/explicit)
+  pool_allocatort(const pool_allocatort<U> &other) : pool(other.pool)
+  {
+  }
+
+  T *allocate(std::size_t n)
+  {
+    if(n != 1)
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+
+    return static_cast<T *>(pool->allocate(sizeof(T)));
+  }
+
+  void deallocate(T *p, std::size_t n)
+  {
+    if(n != 1)
+      ::operator delete(p);
+    else
+      pool->deallocate(p, sizeof(T));
+  }
+
+private:
+  template <typename U>
+  friend class pool_allocatort;
+
+  template <typename U, typename V>
+  friend bool
+  operator==(const pool_allocatort<U> &, const pool_allocatort<V> &);
+
+  std::shared_ptr<memory_poolt> pool;
+};
+
+template <typename T, typename U>
+bool operator==(const pool_allocatort<T> &a, const pool_allocatort<U> &b)
+{
+  return a.pool == b.pool;
+}
+
+template <typename T, typename U>
+bool operator!=(const pool_allocatort<T> &a, const pool_allocatort<U> &b)
+{
+  return !(a == b);
+}
+
+#endif // CPROVER_UTIL_POOL_ALLOCATOR_H
@@ -57,6 +57,12 @@ public:
     return rename(dest);
   }
 
+  /// \return true iff there is nothing to rename
+  bool empty() const
+  {
+    return expr_map.empty() && type_map.empty();
+  }
+
   rename_symbolt();
   virtual ~rename_symbolt();
 
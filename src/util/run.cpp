@@ -218,6 +218,135 @@ std::wstring quote_windows_arg(const std::wstring &src)
 }
 #endif
 
+#ifndef _WIN32
+/// Runs \p what with \p stdin_fd, \p stdout_fd and \p stderr_fd as its
+/// standard input, output and error, and closes those that are not the
+/// standard file descriptors of this process. If \p output_fd is not -1, it is
+/// the read end of a pipe whose write end is \p stdout_fd, and everything the
+/// process writes to it is copied to \p std_output while the process runs.
+/// \return the exit code of the process
+static int run_posix(
+  const std::string &what,
+  const std::vector<std::string> &argv,
+  int stdin_fd,
+  int stdout_fd,
+  int stderr_fd,
+  int output_fd,
+  std::ostream *std_output)
+{
+  if(stdin_fd == -1 || stdout_fd == -1 || stderr_fd == -1)
+  {
+    if(stdin_fd > STDIN_FILENO)
+      close(stdin_fd);
+    if(stdout_fd > STDOUT_FILENO)
+      close(stdout_fd);
+    if(stderr_fd > STDERR_FILENO)
+      close(stderr_fd);
+    if(output_fd != -1)
+      close(output_fd);
+    return 1;
+  }
+
+  // temporarily suspend all signals
+  sigset_t new_mask, old_mask;
+  sigemptyset(&new_mask);
+  sigprocmask(SIG_SETMASK, &new_mask, &old_mask);
+
+  /* now create new process */
+  pid_t childpid = fork();
+
+  if(childpid == 0) /* fork() returns 0 to the child process */
+  {
+    // resume signals
+    remove_signal_catcher();
+    sigprocmask(SIG_SETMASK, &old_mask, nullptr);
+
+    std::vector<char *> _argv(argv.size() + 1);
+    for(std::size_t i = 0; i < argv.size(); i++)
+      _argv[i] = strdup(argv[i].c_str());
+
+    _argv[argv.size()] = nullptr;
+
+    if(output_fd != -1)
+      close(output_fd);
+    if(stdin_fd != STDIN_FILENO)
+      dup2(stdin_fd, STDIN_FILENO);
+    if(stdout_fd != STDOUT_FILENO)
+      dup2(stdout_fd, STDOUT_FILENO);
+    if(stderr_fd != STDERR_FILENO)
+      dup2(stderr_fd, STDERR_FILENO);
+
+    errno = 0;
+    execvp(what.c_str(), _argv.data());
+
+    /* usually no return */
+    perror(std::string("execvp " + what + " failed").c_str());
+    exit(1);
+  }
+
+  // must do before resuming signals to avoid race
+  if(childpid > 0)
+    register_child(childpid);
+
+  // resume signals
+  sigprocmask(SIG_SETMASK, &old_mask, nullptr);
+
+  // the child has its own copies; the write end of the output pipe must be
+  // closed here for reading it to end when the child exits
+  if(stdin_fd != STDIN_FILENO)
+    close(stdin_fd);
+  if(stdout_fd != STDOUT_FILENO)
+    close(stdout_fd);
+  if(stderr_fd != STDERR_FILENO)
+    close(stderr_fd);
+
+  if(childpid < 0) /* fork returns -1 on failure */
+  {
+    if(output_fd != -1)
+      close(output_fd);
+    return 1;
+  }
+
+  if(output_fd != -1)
+  {
+    char buffer[1 << 16];
+    while(true)
+    {
+      const ssize_t bytes_read = read(output_fd, buffer, sizeof(buffer));
+      if(bytes_read > 0)
+        std_output->write(buffer, bytes_read);
+      else if(bytes_read == 0 || errno != EINTR)
+        break;
+    }
+    close(output_fd);
+  }
+
+  int status; /* parent process: child's exit status */
+
+  /* wait for child to exit, and store its status */
+  while(waitpid(childpid, &status, 0) == -1)
+  {
+    if(errno == EINTR)
+      continue; // try again
+    else
+    {
+      unregister_child();
+
+      perror("Waiting for child process failed");
+      return 1;
+    }
+  }
+
+  unregister_child();
+
+  // as a shell does, report termination by a signal as 128 + its number
+  if(!WIFEXITED(status))
+    return WIFSIGNALED(status) ? 128 + WTERMSIG(status) : 1;
+
+  return WEXITSTATUS(status);
+}
+#endif
+
 int run(
   const std::string &what,
   const std::vector<std::string> &argv,
@@ -306,182 +435,17 @@ int run(
   return exit_code;
 
 #else
-  int stdin_fd = stdio_redirection(STDIN_FILENO, std_input);
-  int stdout_fd = stdio_redirection(STDOUT_FILENO, std_output);
-  int stderr_fd = stdio_redirection(STDERR_FILENO, std_error);
-
-  if(stdin_fd == -1 || stdout_fd == -1 || stderr_fd == -1)
-    return 1;
-
-  // temporarily suspend all signals
-  sigset_t new_mask, old_mask;
-  sigemptyset(&new_mask);
-  sigprocmask(SIG_SETMASK, &new_mask, &old_mask);
-
-  /* now create new process */
-  pid_t childpid = fork();
-
-  if(childpid>=0) /* fork succeeded */
-  {
-    if(childpid==0) /* fork() returns 0 to the child process */
-    {
-      // resume signals
-      remove_signal_catcher();
-      sigprocmask(SIG_SETMASK, &old_mask, nullptr);
-
-      std::vector<char *> _argv(argv.size()+1);
-      for(std::size_t i=0; i<argv.size(); i++)
-        _argv[i]=strdup(argv[i].c_str());
-
-      _argv[argv.size()]=nullptr;
-
-      if(stdin_fd!=STDIN_FILENO)
-        dup2(stdin_fd, STDIN_FILENO);
-      if(stdout_fd!=STDOUT_FILENO)
-        dup2(stdout_fd, STDOUT_FILENO);
-      if(stderr_fd != STDERR_FILENO)
-        dup2(stderr_fd, STDERR_FILENO);
-
-      errno=0;
-      execvp(what.c_str(), _argv.data());
-
-      /* usually no return */
-      perror(std::string("execvp "+what+" failed").c_str());
-      exit(1);
-    }
-    else /* fork() returns new pid to the parent process */
-    {
-      // must do before resuming signals to avoid race
-      register_child(childpid);
-
-      // resume signals
-      sigprocmask(SIG_SETMASK, &old_mask, nullptr);
-
-      int status;     /* parent process: child's exit status */
-
-      /* wait for child to exit, and store its status */
-      while(waitpid(childpid, &status, 0)==-1)
-      {
-        if(errno==EINTR)
-          continue; // try again
-        else
-        {
-          unregister_child();
-
-          perror("Waiting for child process failed");
-          if(stdin_fd!=STDIN_FILENO)
-            close(stdin_fd);
-          if(stdout_fd!=STDOUT_FILENO)
-            close(stdout_fd);
-          if(stderr_fd != STDERR_FILENO)
-            close(stderr_fd);
-          return 1;
-        }
-      }
-
-      unregister_child();
-
-      if(stdin_fd!=STDIN_FILENO)
-        close(stdin_fd);
-      if(stdout_fd!=STDOUT_FILENO)
-        close(stdout_fd);
-      if(stderr_fd != STDERR_FILENO)
-        close(stderr_fd);
-
-      return WEXITSTATUS(status);
-    }
-  }
-  else /* fork returns -1 on failure */
-  {
-    // resume signals
-    sigprocmask(SIG_SETMASK, &old_mask, nullptr);
-
-    if(stdin_fd!=STDIN_FILENO)
-      close(stdin_fd);
-    if(stdout_fd!=STDOUT_FILENO)
-      close(stdout_fd);
-    if(stderr_fd != STDERR_FILENO)
-      close(stderr_fd);
-
-    return 1;
-  }
+  return run_posix(
+    what,
+    argv,
+    stdio_redirection(STDIN_FILENO, std_input),
+    stdio_redirection(STDOUT_FILENO, std_output),
+    stdio_redirection(STDERR_FILENO, std_error),
+    -1,
+    nullptr);
 #endif
 }
 
-/// quote a string for bash and CMD
-static std::string shell_quote(const std::string &src)
-{
-  #ifdef _WIN32
-  // first check if quoting is needed at all
-
-  if(src.find(' ')==std::string::npos &&
-     src.find('"')==std::string::npos &&
-     src.find('&')==std::string::npos &&
-     src.find('|')==std::string::npos &&
-     src.find('(')==std::string::npos &&
-     src.find(')')==std::string::npos &&
-     src.find('<')==std::string::npos &&
-     src.find('>')==std::string::npos &&
-     src.find('^')==std::string::npos)
-  {
-    // seems fine -- return as is
-    return src;
-  }
-
-  std::string result;
-
-  result+='"';
-
-  for(const char ch : src)
-  {
-    if(ch=='"')
-      result+='"'; // quotes are doubled
-    result+=ch;
-  }
-
-  result+='"';
-
-  return result;
-
-  #else
-
-  // first check if quoting is needed at all
-
-  if(src.find(' ')==std::string::npos &&
-     src.find('"')==std::string::npos &&
-     src.find('*')==std::string::npos &&
-     src.find('$')==std::string::npos &&
-     src.find('\\')==std::string::npos &&
-     src.find('?')==std::string::npos &&
-     src.find('&')==std::string::npos &&
-     src.find('|')==std::string::npos &&
-     src.find('>')==std::string::npos &&
-     src.find('<')==std::string::npos &&
-     src.find('^')==std::string::npos &&
-     src.find('\'')==std::string::npos)
-  {
-    // seems fine -- return as is
-    return src;
-  }
-
-  std::string result;
-
-  // the single quotes catch everything but themselves!
-  result+='\'';
-
-  for(const char ch : src)
-  {
-    if(ch=='\'')
-      result+="'\\''";
-    result+=ch;
-  }
-
-  result+='\'';
-
-  return result;
-  #endif
-}
-
 int run(
   const std::string &what,
   const std::vector<std::string> &argv,
@@ -501,39 +465,21 @@ int run(
 
   return result;
   #else
-  std::string command;
-
-  bool first = true;
-
-  // note we use 'what' instead of 'argv[0]' as the name of the executable
-  for(const auto &arg : argv)
+  // read the output through a pipe while the process runs
+  int pipe_fds[2];
+  if(pipe(pipe_fds) != 0)
   {
-    if(first) // this is argv[0]
-    {
-      command += shell_quote(what);
-      first = false;
-    }
-    else
-      command += " " + shell_quote(arg);
+    perror("Failed to create pipe");
+    return 1;
   }
 
-  if(!std_input.empty())
-    command += " < " + shell_quote(std_input);
-
-  if(!std_error.empty())
-    command += " 2> " + shell_quote(std_error);
-
-  FILE *stream=popen(command.c_str(), "r");
-
-  if(stream!=nullptr)
-  {
-    int ch;
-    while((ch=fgetc(stream))!=EOF)
-      std_output << (unsigned char)ch;
-
-    return pclose(stream);
-  }
-  else
-    return -1;
+  return run_posix(
+    what,
+    argv,
+    stdio_redirection(STDIN_FILENO, std_input),
+    pipe_fds[1],
+    stdio_redirection(STDERR_FILENO, std_error),
+    pipe_fds[0],
+    &std_output);
   #endif
 }
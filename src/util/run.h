@@ -22,8 +22,10 @@ int run(const std::string &what, const std::vector<std::string> &argv);
 /// Control returns when execution has finished.
 /// Stdin, stdout and stderr may be redirected from/to a given file.
 /// Give the empty string to retain the default handle.
-/// Any shell-meta characters in the executable, \p argv and the I/O
-/// redirect files are escaped as needed.
+/// No shell is involved: \p argv is passed to the executable as given,
+/// quoted as needed for the command line on Windows.
+/// \return the exit code of the executable; on POSIX systems, 128 plus the
+///   number of the signal if it was terminated by one
 int run(
   const std::string &what,
   const std::vector<std::string> &argv,
@@ -35,9 +37,13 @@ int run(
 /// Control returns when execution has finished.
 /// Stdin and stderr may be redirected from/to a given file.
 /// Give the empty string to retain the default handle.
-/// Any output to stdout is stored in the \p std_output stream buffer.
-/// Any shell-meta characters in the executable, \p argv and the I/O
-/// redirect files are escaped as needed.
+/// Any output to stdout is stored in the \p std_output stream buffer; except
+/// on Windows, it is read from a pipe while the executable runs, without a
+/// shell or temporary file in between.
+/// No shell is involved: \p argv is passed to the executable as given,
+/// quoted as needed for the command line on Windows.
+/// \return the exit code of the executable; on POSIX systems, 128 plus the
+///   number of the signal if it was terminated by one
 int run(
   const std::string &what,
   const std::vector<std::string> &argv,
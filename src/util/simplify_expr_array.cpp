@@ -72,7 +72,27 @@ simplify_exprt::simplify_index(const index_exprt &expr)
     // we have (a WITH [i:=e])[j]
 
     if(array.operands().size() != 3)
-      return unchanged(expr);
+    {
+      // (a WITH [i1:=e1, i2:=e2, ...])[j], as built for the initializers of
+      // large arrays, with constant indices
+      const auto j = numeric_cast<mp_integer>(index);
+      if(!j.has_value())
+        return unchanged(expr);
+
+      // the last update of an index wins
+      const exprt::operandst &operands = array.operands();
+      for(std::size_t i = operands.size() - 1; i >= 2; i -= 2)
+      {
+        const auto where = numeric_cast<mp_integer>(operands[i - 1]);
+        if(!where.has_value())
+          return unchanged(expr);
+        else if(*where == *j)
+          return operands[i];
+      }
+
+      return changed(
+        simplify_index(index_exprt(array.op0(), index, new_expr.type())));
+    }
 
     const auto &with_expr = to_with_expr(array);
 
@@ -14,6 +14,10 @@ Author: Daniel Poetzl
 #include <type_traits>
 #include <utility>
 
+#ifdef CPROVER_THREAD_SAFE
+#include <atomic>
+#endif
+
 #include "invariant.h"
 
 /// Get the type with the given index in the parameter pack
@@ -245,9 +249,10 @@ private:
       return;
     }
 
-    if(p->get_use_count() > 1)
+    // With CPROVER_THREAD_SAFE, another owner may release its reference
+    // concurrently: only the decrement itself tells whether this was the last
+    if(p->decrement_use_count() != 0)
     {
-      p->decrement_use_count();
       return;
     }
 
@@ -343,11 +348,12 @@ public:
     ++use_count;
   }
 
-  void decrement_use_count()
+  /// \return the use count after the decrement
+  Num decrement_use_count()
   {
     PRECONDITION(get_use_count() > 0);
 
-    --use_count;
+    return --use_count & use_count_mask;
   }
 
   template <std::size_t I>
@@ -373,7 +379,14 @@ public:
   }
 
 private:
+  /// The use count in the lower bits, the index of the derived type in the
+  /// upper ones. With CPROVER_THREAD_SAFE it is atomic, such that objects
+  /// shared by copies of, e.g., a sharing_mapt can be used by several threads.
+#ifdef CPROVER_THREAD_SAFE
+  std::atomic<Num> use_count{0};
+#else
   Num use_count = 0;
+#endif
 
   static const int bit_width = std::numeric_limits<Num>::digits;
 
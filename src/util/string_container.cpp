@@ -13,6 +13,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <cstring>
 
+#include "invariant.h"
+
 string_ptrt::string_ptrt(const char *_s):s(_s), len(strlen(_s))
 {
 }
@@ -29,6 +31,8 @@ string_containert::~string_containert()
 {
 }
 
+#ifndef CPROVER_THREAD_SAFE
+
 unsigned string_containert::get(const char *s)
 {
   string_ptrt string_ptr(s);
@@ -74,3 +78,59 @@ unsigned string_containert::get(const std::string &s)
 
   return r;
 }
+
+#else
+
+unsigned string_containert::get(const char *s)
+{
+  string_ptrt string_ptr(s);
+  return get(string_ptr, string_ptr_hash()(string_ptr));
+}
+
+unsigned string_containert::get(const std::string &s)
+{
+  string_ptrt string_ptr(s);
+  return get(string_ptr, string_ptr_hash()(string_ptr));
+}
+
+unsigned
+string_containert::get(const string_ptrt &string_ptr, std::size_t hash)
+{
+  // The same string always maps to the same shard, hence holding the shard
+  // lock across the insertion below rules out duplicate entries.
+  shardt &shard = shards[hash % number_of_shards];
+  std::lock_guard<std::mutex> shard_lock(shard.mutex);
+
+  hash_tablet::iterator it = shard.hash_table.find(string_ptr);
+
+  if(it != shard.hash_table.end())
+    return it->second;
+
+  std::string *stored;
+  std::size_t r;
+
+  {
+    std::lock_guard<std::mutex> storage_lock(storage_mutex);
+
+    r = next_number++;
+    INVARIANT(
+      r < number_of_chunks * chunk_size, "string container must not overflow");
+
+    // these are stable
+    string_list.push_back(std::string(string_ptr.s, string_ptr.len));
+    stored = &string_list.back();
+
+    std::unique_ptr<std::string *[]> &chunk = chunks[r >> chunk_bits];
+    if(!chunk)
+      chunk.reset(new std::string *[chunk_size]);
+    chunk[r & (chunk_size - 1)] = stored;
+  }
+
+  // Readers obtain 'r' only via a shard lookup (or via a thread that did
+  // one), which synchronises with the writes to the chunk above.
+  shard.hash_table[string_ptrt(*stored)] = r;
+
+  return r;
+}
+
+#endif
@@ -16,6 +16,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <unordered_map>
 #include <vector>
 
+#ifdef CPROVER_THREAD_SAFE
+#include <atomic>
+#include <memory>
+#include <mutex>
+#endif
+
 #include "string_hash.h"
 
 struct string_ptrt
@@ -44,6 +50,12 @@ public:
   size_t operator()(const string_ptrt s) const { return hash_string(s.s); }
 };
 
+/// Maps strings to dense, stable numbers and back.
+///
+/// When built with `CPROVER_THREAD_SAFE` the table is lock-striped: lookups
+/// and insertions only lock the shard selected by the hash of the string,
+/// and the number-to-string direction is stored in fixed-size chunks that are
+/// never moved, so that \ref c_str and \ref get_string need no locking.
 class string_containert
 {
 public:
@@ -61,6 +73,7 @@ public:
   string_containert();
   ~string_containert();
 
+#ifndef CPROVER_THREAD_SAFE
   // the pointer is guaranteed to be stable
   const char *c_str(size_t no) const
   {
@@ -72,12 +85,24 @@ public:
   {
     return *string_vector[no];
   }
+#else
+  // the pointer is guaranteed to be stable
+  const char *c_str(size_t no) const
+  {
+    return get_string(no).c_str();
+  }
+
+  // the reference is guaranteed to be stable
+  const std::string &get_string(size_t no) const
+  {
+    return *chunks[no >> chunk_bits][no & (chunk_size - 1)];
+  }
+#endif
 
 protected:
   // the 'unsigned' ought to be size_t
   typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
     hash_tablet;
-  hash_tablet hash_table;
 
   unsigned get(const char *s);
   unsigned get(const std::string &s);
@@ -85,8 +110,34 @@ protected:
   typedef std::list<std::string> string_listt;
   string_listt string_list;
 
+#ifndef CPROVER_THREAD_SAFE
+  hash_tablet hash_table;
+
   typedef std::vector<std::string *> string_vectort;
   string_vectort string_vector;
+#else
+  unsigned get(const string_ptrt &string_ptr, std::size_t hash);
+
+  /// A shard of the string-to-number table together with its lock
+  struct shardt
+  {
+    std::mutex mutex;
+    hash_tablet hash_table;
+  };
+
+  static constexpr std::size_t number_of_shards = 64;
+  shardt shards[number_of_shards];
+
+  // Numbers are 'unsigned', hence 2^16 chunks of 2^16 entries suffice.
+  static constexpr std::size_t chunk_bits = 16;
+  static constexpr std::size_t chunk_size = std::size_t(1) << chunk_bits;
+  static constexpr std::size_t number_of_chunks = std::size_t(1) << 16;
+  std::unique_ptr<std::string *[]> chunks[number_of_chunks];
+
+  /// Protects \ref string_list and the allocation of new chunks
+  std::mutex storage_mutex;
+  std::size_t next_number = 0;
+#endif
 };
 
 /// Get a reference to the global string container.
@@ -11,6 +11,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "string_hash.h"
 
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+
 size_t hash_string(const std::string &s)
 {
   size_t h=0;
@@ -31,3 +35,24 @@ size_t hash_string(const char *s)
 
   return h;
 }
+
+/// 64-bit FNV-1a hash of \p s, starting from \p basis
+static std::uint64_t fnv1a(const std::string &s, std::uint64_t basis)
+{
+  std::uint64_t h = basis;
+  for(const char c : s)
+  {
+    h ^= static_cast<unsigned char>(c);
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+std::string string_digest(const std::string &s)
+{
+  std::ostringstream result;
+  result << std::hex << std::setfill('0') << std::setw(16)
+         << fnv1a(s, 0xcbf29ce484222325ULL) << std::setw(16)
+         << fnv1a(s, 0x84222325cbf29ce4ULL);
+  return result.str();
+}
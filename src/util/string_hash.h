@@ -17,6 +17,11 @@ Author: Daniel Kroening, kroening@kroening.com
 size_t hash_string(const std::string &s);
 size_t hash_string(const char *s);
 
+/// A digest of \p s that, unlike \ref hash_string, is suitable for telling
+/// apart contents stored across runs, such as files in a cache: two 64-bit
+/// FNV-1a hashes with different offset bases, as 32 hexadecimal digits
+std::string string_digest(const std::string &s);
+
 // NOLINTNEXTLINE(readability/identifiers)
 struct string_hash
 {
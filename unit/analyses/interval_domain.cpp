@@ -0,0 +1,75 @@
+/*******************************************************************\
+
+Module: Unit tests for interval_domaint
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/interval_domain.h>
+
+#include <util/arith_tools.h>
+#include <util/std_types.h>
+#include <util/symbol_table.h>
+
+SCENARIO("interval_domaint join", "[core][analyses][interval_domain]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+  goto_programt program;
+  const auto location = program.add(goto_programt::make_skip());
+
+  const signedbv_typet type(32);
+  const symbol_exprt x("x", type);
+  const symbol_exprt y("y", type);
+  const binary_relation_exprt x_le_3(x, ID_le, from_integer(3, type));
+  const binary_relation_exprt x_le_5(x, ID_le, from_integer(5, type));
+  const binary_relation_exprt y_ge_0(y, ID_ge, from_integer(0, type));
+
+  GIVEN("A state with x <= 5 and y >= 0")
+  {
+    interval_domaint a;
+    a.make_top();
+    a.assume(x_le_5, ns);
+    a.assume(y_ge_0, ns);
+
+    interval_domaint stronger = a;
+    stronger.assume(x_le_3, ns);
+    REQUIRE(stronger.make_expression(x) == x_le_3);
+
+    WHEN("Joining a stronger state")
+    {
+      THEN("The state is unchanged")
+      {
+        REQUIRE_FALSE(a.merge(stronger, location, location));
+        REQUIRE(a.make_expression(x) == x_le_5);
+        REQUIRE(a.make_expression(y) != true_exprt());
+      }
+    }
+
+    WHEN("Joining into the stronger state")
+    {
+      THEN("It becomes the weaker one")
+      {
+        REQUIRE(stronger.merge(a, location, location));
+        REQUIRE(stronger.make_expression(x) == x_le_5);
+      }
+    }
+
+    WHEN("Joining a state that does not constrain y")
+    {
+      interval_domaint other;
+      other.make_top();
+      other.assume(x_le_3, ns);
+
+      THEN("y becomes unconstrained")
+      {
+        REQUIRE(a.merge(other, location, location));
+        REQUIRE(a.make_expression(x) == x_le_5);
+        REQUIRE(a.make_expression(y) == true_exprt());
+      }
+    }
+  }
+}
@@ -254,3 +254,69 @@ TEST_CASE("arbitrary precision integers", "[core][big-int][bigint]")
     REQUIRE(N.floorPow2() == 1);
   }
 }
+
+TEST_CASE("small and large integers", "[core][big-int][bigint]")
+{
+  const BigInt small(-12345);
+  const BigInt large = pow(BigInt(7), 100);
+  const std::string large_string = to_string(large);
+
+  SECTION("Copying")
+  {
+    BigInt a(small);
+    BigInt b(large);
+    REQUIRE(a == small);
+    REQUIRE(b == large);
+
+    a = large;
+    b = small;
+    REQUIRE(a == large);
+    REQUIRE(b == small);
+
+    const BigInt &alias = a;
+    a = alias;
+    REQUIRE(a == large);
+  }
+
+  SECTION("Swapping")
+  {
+    BigInt a(small);
+    BigInt b(large);
+    BigInt c(3);
+
+    a.swap(b);
+    REQUIRE(a == large);
+    REQUIRE(b == small);
+
+    b.swap(c);
+    REQUIRE(b == 3);
+    REQUIRE(c == small);
+
+    a.swap(a);
+    REQUIRE(to_string(a) == large_string);
+  }
+
+  SECTION("Moving")
+  {
+    BigInt a(small);
+    BigInt b(std::move(a));
+    REQUIRE(b == small);
+
+    BigInt c(large);
+    a = std::move(c);
+    REQUIRE(a == large);
+  }
+
+  SECTION("Growing beyond and shrinking below 64 bits")
+  {
+    BigInt a(BigInt::ullong_t(-1));
+    a += 1;
+    REQUIRE(to_string(a) == "18446744073709551616");
+    a *= a;
+    REQUIRE(to_string(a) == "340282366920938463463374607431768211456");
+    a /= BigInt(BigInt::ullong_t(-1)) + 1;
+    REQUIRE(to_string(a) == "18446744073709551616");
+    a -= 1;
+    REQUIRE(a == BigInt(BigInt::ullong_t(-1)));
+  }
+}
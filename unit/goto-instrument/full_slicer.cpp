@@ -0,0 +1,134 @@
+/*******************************************************************\
+
+Module: Unit tests for persistent_full_slicert
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/config.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+#include <goto-instrument/full_slicer.h>
+#include <goto-instrument/full_slicer_class.h>
+
+static symbol_exprt add_variable(symbol_tablet &symbol_table, irep_idt name)
+{
+  symbolt symbol;
+  symbol.name = id2string(goto_functionst::entry_point()) + "::" +
+                id2string(name);
+  symbol.base_name = name;
+  symbol.type = signed_int_type();
+  symbol.is_lvalue = true;
+  symbol.is_state_var = true;
+  symbol.is_thread_local = true;
+  symbol.is_file_local = true;
+  symbol_table.add(symbol);
+  return symbol.symbol_expr();
+}
+
+static std::size_t
+count_assignments_to(const goto_functionst &goto_functions, irep_idt name)
+{
+  std::size_t count = 0;
+  forall_goto_functions(f_it, goto_functions)
+  {
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      if(
+        i_it->is_assign() &&
+        to_symbol_expr(i_it->get_assign().lhs()).get_identifier() == name)
+      {
+        ++count;
+      }
+    }
+  }
+  return count;
+}
+
+SCENARIO("persistent_full_slicer", "[core][goto-instrument][full_slicer]")
+{
+  GIVEN("A program with two properties depending on different variables")
+  {
+    // DECL x; DECL y; x = 1; y = 2;
+    // ASSERT x == 1 (property p1); ASSERT y == 2 (property p2)
+    config.ansi_c.set_LP64();
+
+    goto_modelt goto_model;
+    const namespacet ns(goto_model.symbol_table);
+
+    const symbol_exprt x = add_variable(goto_model.symbol_table, "x");
+    const symbol_exprt y = add_variable(goto_model.symbol_table, "y");
+    const typet &int_type = x.type();
+
+    source_locationt p1_location;
+    p1_location.set_property_id("p1");
+    source_locationt p2_location;
+    p2_location.set_property_id("p2");
+
+    goto_programt &body =
+      goto_model.goto_functions.function_map[goto_functionst::entry_point()]
+        .body;
+    body.add(goto_programt::make_decl(x));
+    body.add(goto_programt::make_decl(y));
+    body.add(goto_programt::make_assignment(x, from_integer(1, int_type)));
+    const goto_programt::targett y_assignment = body.add(
+      goto_programt::make_assignment(y, from_integer(2, int_type)));
+    body.add(goto_programt::make_assertion(
+      equal_exprt(x, from_integer(1, int_type)), p1_location));
+    body.add(goto_programt::make_assertion(
+      equal_exprt(y, from_integer(2, int_type)), p2_location));
+    body.add(goto_programt::make_end_function());
+    goto_model.goto_functions.update();
+
+    persistent_full_slicert slicer(goto_model.goto_functions, ns);
+
+    WHEN("Slicing copies of the program for each property")
+    {
+      const std::list<std::string> p1{"p1"};
+      goto_functionst slice1;
+      slice1.copy_from(goto_model.goto_functions);
+      slicer(slice1, properties_criteriont(p1));
+
+      const std::list<std::string> p2{"p2"};
+      goto_functionst slice2;
+      slice2.copy_from(goto_model.goto_functions);
+      slicer(slice2, properties_criteriont(p2));
+
+      THEN("Each slice only keeps the assignment the property depends on")
+      {
+        REQUIRE(count_assignments_to(slice1, x.get_identifier()) == 1);
+        REQUIRE(count_assignments_to(slice1, y.get_identifier()) == 0);
+        REQUIRE(count_assignments_to(slice2, x.get_identifier()) == 0);
+        REQUIRE(count_assignments_to(slice2, y.get_identifier()) == 1);
+      }
+
+      THEN("The original program is unchanged")
+      {
+        REQUIRE(body.instructions.size() == 7);
+        REQUIRE(!slicer.update());
+      }
+    }
+
+    WHEN("The program is transformed")
+    {
+      y_assignment->code = code_assignt(y, from_integer(3, int_type));
+      goto_model.goto_functions.update();
+
+      THEN("The dependence graph is recomputed and slicing still works")
+      {
+        REQUIRE(slicer.update());
+
+        const std::list<std::string> p2{"p2"};
+        goto_functionst slice2;
+        slice2.copy_from(goto_model.goto_functions);
+        slicer(slice2, properties_criteriont(p2));
+        REQUIRE(count_assignments_to(slice2, x.get_identifier()) == 0);
+        REQUIRE(count_assignments_to(slice2, y.get_identifier()) == 1);
+      }
+    }
+  }
+}
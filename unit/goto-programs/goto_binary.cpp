@@ -0,0 +1,113 @@
+/*******************************************************************\
+
+Module: Unit tests for writing and reading goto binaries
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/config.h>
+#include <util/std_code.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include <sstream>
+
+/// Build a model with a global x and a function f that assigns the values
+/// 0 to \p count - 1 to x
+static void build_model(goto_modelt &goto_model, std::size_t count)
+{
+  symbolt x;
+  x.name = "x";
+  x.base_name = "x";
+  x.type = signed_int_type();
+  x.is_static_lifetime = true;
+  x.is_lvalue = true;
+  goto_model.symbol_table.add(x);
+
+  const code_typet type({}, empty_typet());
+  symbolt f;
+  f.name = "f";
+  f.base_name = "f";
+  f.mode = ID_C;
+  f.type = type;
+  goto_model.symbol_table.add(f);
+
+  goto_functionst::goto_functiont &function =
+    goto_model.goto_functions.function_map["f"];
+  function.type = type;
+  for(std::size_t i = 0; i < count; ++i)
+  {
+    function.body.add(goto_programt::make_assignment(
+      x.symbol_expr(), from_integer(i, x.type)));
+  }
+  function.body.add(goto_programt::make_end_function());
+  goto_model.goto_functions.update();
+}
+
+static void check_round_trip(std::size_t count, bool compress)
+{
+  config.ansi_c.set_LP64();
+
+  goto_modelt goto_model;
+  build_model(goto_model, count);
+
+  std::stringstream stream;
+  REQUIRE_FALSE(
+    write_goto_binary(stream, goto_model, GOTO_BINARY_VERSION, compress));
+  stream << "trailer";
+
+  goto_modelt read_model;
+  REQUIRE_FALSE(read_bin_goto_object(
+    stream,
+    "",
+    read_model.symbol_table,
+    read_model.goto_functions,
+    null_message_handler));
+
+  REQUIRE(read_model.symbol_table.has_symbol("x"));
+  REQUIRE(read_model.symbol_table.lookup_ref("f").mode == ID_C);
+
+  const goto_programt &body =
+    read_model.goto_functions.function_map.at("f").body;
+  REQUIRE(body.instructions.size() == count + 1);
+  REQUIRE(
+    body.instructions.front().get_assign().lhs() ==
+    read_model.symbol_table.lookup_ref("x").symbol_expr());
+  REQUIRE(
+    numeric_cast_v<std::size_t>(to_constant_expr(
+      std::prev(body.instructions.end(), 2)->get_assign().rhs())) ==
+    count - 1);
+
+  // whatever follows the goto binary remains readable
+  std::string trailer;
+  stream >> trailer;
+  REQUIRE(trailer == "trailer");
+}
+
+TEST_CASE(
+  "Goto binaries can be read back",
+  "[core][goto-programs][goto_binary]")
+{
+  SECTION("Uncompressed")
+  {
+    check_round_trip(10, false);
+  }
+
+  SECTION("Compressed")
+  {
+    check_round_trip(10, true);
+  }
+
+  SECTION("Compressed in several blocks")
+  {
+    check_round_trip(50000, true);
+  }
+}
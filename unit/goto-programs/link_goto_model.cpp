@@ -0,0 +1,137 @@
+/*******************************************************************\
+
+Module: Unit tests for link_goto_model
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/config.h>
+#include <util/message.h>
+#include <util/std_code.h>
+#include <util/std_types.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/link_goto_model.h>
+
+static void add_global(goto_modelt &goto_model)
+{
+  symbolt x;
+  x.name = "x";
+  x.base_name = "x";
+  x.type = signed_int_type();
+  x.is_static_lifetime = true;
+  x.is_lvalue = true;
+  x.value = from_integer(0, x.type);
+  goto_model.symbol_table.add(x);
+}
+
+/// Add a function \p name that assigns \p value to the global x and, if
+/// \p callee is not empty, then calls \p callee
+static void add_function(
+  goto_modelt &goto_model,
+  const irep_idt &name,
+  int value,
+  bool is_weak,
+  bool is_file_local,
+  const irep_idt &callee = irep_idt())
+{
+  const code_typet type({}, empty_typet());
+
+  symbolt symbol;
+  symbol.name = name;
+  symbol.base_name = name;
+  symbol.type = type;
+  symbol.value = code_blockt();
+  symbol.is_weak = is_weak;
+  symbol.is_file_local = is_file_local;
+  goto_model.symbol_table.add(symbol);
+
+  const symbol_exprt x("x", signed_int_type());
+  goto_functionst::goto_functiont &function =
+    goto_model.goto_functions.function_map[name];
+  function.type = type;
+  function.body.add(
+    goto_programt::make_assignment(x, from_integer(value, x.type())));
+  if(!callee.empty())
+  {
+    function.body.add(goto_programt::make_function_call(
+      code_function_callt(symbol_exprt(callee, type))));
+  }
+  function.body.add(goto_programt::make_end_function());
+}
+
+static void add_struct(goto_modelt &goto_model)
+{
+  symbolt symbol;
+  symbol.name = "tag-S";
+  symbol.base_name = "S";
+  symbol.type = struct_typet({{"a", signed_int_type()}});
+  symbol.is_type = true;
+  goto_model.symbol_table.add(symbol);
+}
+
+/// \return the value the first instruction of \p function assigns to x
+static mp_integer assigned_value(const goto_modelt &goto_model, irep_idt name)
+{
+  const auto &function = goto_model.goto_functions.function_map.at(name);
+  const exprt &rhs = function.body.instructions.front().get_assign().rhs();
+  return numeric_cast_v<mp_integer>(to_constant_expr(rhs));
+}
+
+SCENARIO("Linking goto models", "[core][goto-programs][link_goto_model]")
+{
+  config.ansi_c.set_LP64();
+
+  GIVEN("Two models with shared, weak and file-local definitions")
+  {
+    goto_modelt dest;
+    add_global(dest);
+    add_struct(dest);
+    add_function(dest, "f", 1, true, false);
+    add_function(dest, "h", 3, false, true);
+
+    goto_modelt src;
+    add_global(src);
+    add_struct(src);
+    add_function(src, "f", 2, false, false);
+    add_function(src, "h", 4, false, true);
+    add_function(src, "g", 5, false, false, "h");
+
+    null_message_handlert message_handler;
+    link_goto_model(dest, src, message_handler);
+
+    THEN("The identical type is kept once")
+    {
+      REQUIRE(dest.symbol_table.has_symbol("tag-S"));
+
+      std::size_t type_symbols = 0;
+      for(const auto &symbol_pair : dest.symbol_table.symbols)
+      {
+        if(symbol_pair.second.is_type)
+          ++type_symbols;
+      }
+      REQUIRE(type_symbols == 1);
+    }
+
+    THEN("The strong definition replaces the weak one")
+    {
+      REQUIRE(assigned_value(dest, "f") == 2);
+    }
+
+    THEN("File-local functions are renamed, including their calls")
+    {
+      REQUIRE(assigned_value(dest, "h") == 3);
+      REQUIRE(assigned_value(dest, "h$link1") == 4);
+
+      const auto &g = dest.goto_functions.function_map.at("g");
+      const auto &call =
+        std::next(g.body.instructions.begin())->get_function_call();
+      REQUIRE(to_symbol_expr(call.function()).get_identifier() == "h$link1");
+    }
+  }
+}
@@ -0,0 +1,73 @@
+/*******************************************************************\
+
+Module: Unit tests for dense_bitvectort
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/dense_bitvector.h>
+
+#include <vector>
+
+static std::vector<std::size_t> elements(const dense_bitvectort &bv)
+{
+  return std::vector<std::size_t>(bv.begin(), bv.end());
+}
+
+TEST_CASE(
+  "dense_bitvectort insert and erase",
+  "[core][util][dense_bitvector]")
+{
+  dense_bitvectort bv;
+  REQUIRE(bv.empty());
+  REQUIRE(bv.begin() == bv.end());
+
+  REQUIRE(bv.insert(3));
+  REQUIRE(bv.insert(64));
+  REQUIRE(bv.insert(200));
+  REQUIRE(!bv.insert(64));
+
+  REQUIRE(bv.contains(3));
+  REQUIRE(bv.contains(64));
+  REQUIRE(!bv.contains(63));
+  REQUIRE(!bv.contains(1000));
+  REQUIRE(elements(bv) == std::vector<std::size_t>{3, 64, 200});
+
+  REQUIRE(bv.erase(200));
+  REQUIRE(!bv.erase(200));
+  REQUIRE(elements(bv) == std::vector<std::size_t>{3, 64});
+
+  REQUIRE(bv.erase(3));
+  REQUIRE(bv.erase(64));
+  REQUIRE(bv.empty());
+  REQUIRE(bv == dense_bitvectort());
+}
+
+TEST_CASE(
+  "dense_bitvectort union and difference",
+  "[core][util][dense_bitvector]")
+{
+  dense_bitvectort a;
+  a.insert(1);
+  a.insert(70);
+
+  dense_bitvectort b;
+  b.insert(70);
+  b.insert(130);
+
+  REQUIRE(a.union_with(b));
+  REQUIRE(elements(a) == std::vector<std::size_t>{1, 70, 130});
+  REQUIRE(!a.union_with(b));
+
+  a.subtract(b);
+  REQUIRE(elements(a) == std::vector<std::size_t>{1});
+
+  // removing the only element of the last word leaves no trailing zero word
+  b.subtract(b);
+  REQUIRE(b.empty());
+  a.erase(1);
+  REQUIRE(a == b);
+}
@@ -0,0 +1,96 @@
+/*******************************************************************\
+
+Module: Unit tests for pool_allocatort
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/pool_allocator.h>
+
+#include <list>
+#include <map>
+#include <string>
+
+TEST_CASE("pool_allocatort with std::list", "[core][util][pool_allocator]")
+{
+  typedef std::list<std::string, pool_allocatort<std::string>> listt;
+
+  listt list;
+  for(int i = 0; i < 100000; ++i)
+    list.push_back(std::to_string(i));
+
+  REQUIRE(list.size() == 100000);
+  REQUIRE(list.front() == "0");
+  REQUIRE(list.back() == "99999");
+
+  SECTION("Released nodes are reused")
+  {
+    const std::string *last = &list.back();
+    list.pop_back();
+    list.push_back("reused");
+    REQUIRE(&list.back() == last);
+    REQUIRE(list.back() == "reused");
+  }
+
+  SECTION("Lists using the pool can be spliced")
+  {
+    listt other(list.get_allocator());
+    other.push_back("first");
+    list.splice(list.begin(), other);
+    REQUIRE(other.empty());
+    REQUIRE(list.size() == 100001);
+    REQUIRE(list.front() == "first");
+  }
+
+  SECTION("Copies are independent")
+  {
+    listt copy = list;
+    copy.front() = "changed";
+    REQUIRE(list.front() == "0");
+    list.clear();
+    REQUIRE(copy.size() == 100000);
+    REQUIRE(copy.back() == "99999");
+  }
+}
+
+TEST_CASE(
+  "pool_allocatort instances share pools with copies only",
+  "[core][util][pool_allocator]")
+{
+  typedef std::list<int, pool_allocatort<int>> listt;
+
+  listt list;
+  list.push_back(1);
+
+  listt copy = list;
+  REQUIRE(copy.get_allocator() == list.get_allocator());
+
+  listt other;
+  REQUIRE(other.get_allocator() != list.get_allocator());
+
+  // assignment takes over the pool of the source, such that the nodes of
+  // both lists can later be spliced
+  other = list;
+  REQUIRE(other.get_allocator() == list.get_allocator());
+  list.splice(list.end(), other);
+  REQUIRE(list.size() == 2);
+}
+
+TEST_CASE("pool_allocatort with std::map", "[core][util][pool_allocator]")
+{
+  std::map<int, int, std::less<int>, pool_allocatort<std::pair<const int, int>>>
+    map;
+
+  for(int i = 0; i < 1000; ++i)
+    map[i] = i * i;
+
+  for(int i = 0; i < 1000; i += 2)
+    map.erase(i);
+
+  REQUIRE(map.size() == 500);
+  REQUIRE(map.at(999) == 999 * 999);
+  REQUIRE(map.find(998) == map.end());
+}
@@ -13,6 +13,11 @@ Author: Daniel Poetzl
 #include <random>
 #include <set>
 
+#ifdef CPROVER_THREAD_SAFE
+#include <thread>
+#include <vector>
+#endif
+
 #include <testing-utils/use_catch.h>
 #include <util/sharing_map.h>
 
@@ -956,3 +961,42 @@ TEST_CASE("Sharing map with a non-default-constructable value", "[core][util]")
   REQUIRE(!entry_2.is_in_both_maps());
   REQUIRE(entry_2.m.val == 2);
 }
+
+#ifdef CPROVER_THREAD_SAFE
+
+TEST_CASE(
+  "Sharing maps can be copied and modified in several threads",
+  "[core][util]")
+{
+  const std::size_t number_of_threads = 8;
+
+  sharing_map_unsignedt shared;
+  for(unsigned i = 0; i < 1000; ++i)
+    shared.insert(i, std::to_string(i));
+
+  // each thread makes copies of the same map, which share all its nodes,
+  // modifies and destroys them
+  std::vector<std::thread> threads;
+  for(std::size_t t = 0; t < number_of_threads; ++t)
+  {
+    threads.emplace_back([t, &shared] {
+      for(unsigned round = 0; round < 100; ++round)
+      {
+        sharing_map_unsignedt copy = shared;
+        copy.replace(static_cast<unsigned>(t + round), "changed");
+        copy.erase(static_cast<unsigned>(500 + t));
+        sharing_map_unsignedt copy_of_copy = copy;
+        copy_of_copy.insert(static_cast<unsigned>(1000 + t), "new");
+      }
+    });
+  }
+
+  for(auto &thread : threads)
+    thread.join();
+
+  REQUIRE(shared.size() == 1000);
+  for(unsigned i = 0; i < 1000; ++i)
+    REQUIRE(shared.find(i).value().get() == std::to_string(i));
+}
+
+#endif
@@ -0,0 +1,147 @@
+/*******************************************************************\
+
+Module: Unit tests for string_containert
+
+\*******************************************************************/
+
+/// \file
+/// Tests and benchmarks for the string table and irep reference counting
+
+#include <testing-utils/use_catch.h>
+
+#include <util/irep.h>
+#include <util/string_container.h>
+
+#include <string>
+#include <vector>
+
+#ifdef CPROVER_THREAD_SAFE
+#include <thread>
+#endif
+
+TEST_CASE("string_containert numbering", "[core][util][string_container]")
+{
+  string_containert &container = get_string_container();
+
+  const unsigned a = container["string_container_test_a"];
+  const unsigned b = container[std::string("string_container_test_b")];
+
+  REQUIRE(a != b);
+  REQUIRE(container["string_container_test_a"] == a);
+  REQUIRE(container[std::string("string_container_test_b")] == b);
+  REQUIRE(container.get_string(a) == "string_container_test_a");
+  REQUIRE(std::string(container.c_str(b)) == "string_container_test_b");
+
+  // numbers are dense
+  const unsigned c = container["string_container_test_c"];
+  REQUIRE(c == b + 1);
+}
+
+#ifdef CPROVER_THREAD_SAFE
+
+TEST_CASE(
+  "string_containert concurrent insertion",
+  "[core][util][string_container]")
+{
+  const std::size_t number_of_threads = 8;
+  const std::size_t strings_per_thread = 2000;
+
+  // all threads insert the same strings, in different orders
+  std::vector<std::vector<irep_idt>> results(number_of_threads);
+  std::vector<std::thread> threads;
+
+  for(std::size_t t = 0; t < number_of_threads; ++t)
+  {
+    threads.emplace_back([t, &results] {
+      for(std::size_t i = 0; i < strings_per_thread; ++i)
+      {
+        const std::size_t n = (t % 2 == 0) ? i : strings_per_thread - 1 - i;
+        results[t].push_back("concurrent_" + std::to_string(n));
+      }
+    });
+  }
+
+  for(auto &thread : threads)
+    thread.join();
+
+  for(std::size_t t = 0; t < number_of_threads; ++t)
+  {
+    REQUIRE(results[t].size() == strings_per_thread);
+    for(std::size_t i = 0; i < strings_per_thread; ++i)
+    {
+      const std::size_t n = (t % 2 == 0) ? i : strings_per_thread - 1 - i;
+      REQUIRE(results[t][i] == results[0][n]);
+      REQUIRE(id2string(results[t][i]) == "concurrent_" + std::to_string(n));
+    }
+  }
+}
+
+TEST_CASE("irept concurrent sharing", "[core][util][irept]")
+{
+  irept shared(ID_1);
+  shared.get_sub().push_back(irept(ID_0));
+
+  std::vector<std::thread> threads;
+  for(std::size_t t = 0; t < 8; ++t)
+  {
+    threads.emplace_back([&shared] {
+      for(std::size_t i = 0; i < 10000; ++i)
+      {
+        irept copy = shared;
+        irept copy_of_sub = copy.get_sub()[0];
+        if(i % 100 == 0)
+          copy.id(ID_symbol); // detaches the copy
+      }
+    });
+  }
+
+  for(auto &thread : threads)
+    thread.join();
+
+  REQUIRE(shared.id() == ID_1);
+  REQUIRE(shared.get_sub().size() == 1);
+  REQUIRE(shared.get_sub()[0].id() == ID_0);
+}
+
+#endif
+
+// Run with `unit "[benchmark]"` in both the default build and a build with
+// CPROVER_THREAD_SAFE to quantify the single-threaded overhead of the latter.
+TEST_CASE("string_containert benchmark", "[.][benchmark]")
+{
+  const std::size_t count = 200000;
+
+  std::vector<std::string> strings;
+  strings.reserve(count);
+  for(std::size_t i = 0; i < count; ++i)
+    strings.push_back("benchmark_" + std::to_string(i));
+
+  std::size_t checksum = 0;
+
+  BENCHMARK("string table: insert")
+  {
+    for(const auto &s : strings)
+      checksum += get_string_container()[s];
+  }
+
+  BENCHMARK("string table: lookup")
+  {
+    for(const auto &s : strings)
+      checksum += get_string_container()[s];
+  }
+
+  irept tree(ID_1);
+  for(std::size_t i = 0; i < 16; ++i)
+    tree.get_sub().push_back(irept(ID_0));
+
+  BENCHMARK("irept: copy and destroy")
+  {
+    for(std::size_t i = 0; i < count; ++i)
+    {
+      irept copy = tree;
+      checksum += copy.get_sub().size();
+    }
+  }
+
+  REQUIRE(checksum != 0);
+}